@@ -9,6 +9,11 @@
 #include <sstream>
 #include <iomanip>
 #include <string>
+#include <numeric>
+#include <cstdio>
+#include <unistd.h>
+#include <cstring>
+#include <sys/statvfs.h>
 
 #include <mpi.h>
 
@@ -46,8 +51,19 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
     keep_n_dumps( 2 ),
     keep_n_dumps_max( 10000 ),
     dump_deflate( 0 ),
+    dump_async( false ),
+    dump_thread_failed( false ),
+    dump_incremental( false ),
+    current_dump( 0 ),
+    current_file_index( 0 ),
+    current_number_of_files( 1 ),
     dump_request( smpi->getSize() ),
-    file_grouping( 0 )
+    file_grouping( 0 ),
+    ranks_per_file( 1 ),
+    restart_ranks_per_file( 1 ),
+    restart_file_grouping( 0 ),
+    restart_file_index( 0 ),
+    restart_num_dump( 0 )
 {
 
     if( PyTools::nComponents( "Checkpoints" ) > 0 ) {
@@ -84,6 +100,40 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
             MESSAGE( 1, "Code will group checkpoint files by "<< file_grouping );
         }
         
+        PyTools::extract( "dump_async", dump_async, "Checkpoints"  );
+        if( dump_async ) {
+            MESSAGE( 1, "Code will write dumps to disk in the background" );
+        }
+        
+        PyTools::extract( "staging_dir", staging_dir, "Checkpoints"  );
+        if( staging_dir != "" ) {
+            MESSAGE( 1, "Code will write dumps in "<< staging_dir << " then copy them in the background" );
+            if( dump_async ) {
+                WARNING( "Checkpoints: `dump_async` is not used when `staging_dir` is set" );
+                dump_async = false;
+            }
+        }
+        
+        PyTools::extract( "dump_incremental", dump_incremental, "Checkpoints"  );
+        if( dump_incremental ) {
+            MESSAGE( 1, "Code will link unchanged data to previous dumps" );
+        }
+        
+        PyTools::extract( "ranks_per_file", ranks_per_file, "Checkpoints"  );
+        if( ranks_per_file < 1 ) {
+            ranks_per_file = 1;
+        }
+        if( ranks_per_file > ( unsigned int )( smpi->getSize() ) ) {
+            ranks_per_file = smpi->getSize();
+        }
+        if( ranks_per_file > 1 && ( dump_async || dump_incremental || staging_dir != "" ) ) {
+            WARNING( "Checkpoints: `ranks_per_file` is not compatible with `dump_async`, `dump_incremental` or `staging_dir` and is reset to 1" );
+            ranks_per_file = 1;
+        }
+        if( ranks_per_file > 1 ) {
+            MESSAGE( 1, "Code will aggregate "<< ranks_per_file << " MPI ranks in each checkpoint file" );
+        }
+        
         smpi->barrier();
         
         if( params.restart ) {
@@ -96,7 +146,7 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
             restart_file = "";
             for( unsigned int num_dump=0; num_dump<restart_files.size(); num_dump++ ) {
                 string dump_name=restart_files[num_dump];
-                hid_t fid = H5::Fopen( dump_name );
+                hid_t fid = H5::Fopen( dump_name, H5F_ACC_RDONLY );
                 if( fid < 0 ) {
                     continue;
                 }
@@ -177,6 +227,11 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
     nDim_particle=params.nDim_particle;
 }
 
+Checkpoint::~Checkpoint()
+{
+    waitDump();
+}
+
 void Checkpoint::dump( VectorPatch &vecPatches, unsigned int itime, SmileiMPI *smpi, SimWindow *simWindow, Params &params )
 {
 
@@ -218,19 +273,64 @@ void Checkpoint::dump( VectorPatch &vecPatches, unsigned int itime, SmileiMPI *s
 
 void Checkpoint::dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMPI *smpi, SimWindow *simWin,  Params &params )
 {
-    unsigned int num_dump=dump_number % keep_n_dumps;
+    // In incremental mode, dumps are not overwritten in turn because they may link to each other
+    unsigned int num_dump = dump_incremental ? dump_number : dump_number % keep_n_dumps;
     
-    ostringstream nameDumpTmp( "" );
-    nameDumpTmp << "checkpoints" << PATH_SEPARATOR;
-    if( file_grouping>0 ) {
-        nameDumpTmp << setfill( '0' ) << setw( int( 1+log10( smpi->getSize()/file_grouping+1 ) ) ) << smpi->getRank()/file_grouping << PATH_SEPARATOR;
+    // Ranks are aggregated in groups of ranks_per_file, each group writing one file.
+    // Inside a group, ranks write one after the other, passing a token to the next rank.
+    unsigned int number_of_files = ( smpi->getSize()-1 ) / ranks_per_file + 1;
+    unsigned int file_index = smpi->getRank() / ranks_per_file;
+    bool first_in_file = ( smpi->getRank() % ranks_per_file == 0 );
+    bool last_in_file  = ( smpi->getRank() % ranks_per_file == ranks_per_file-1 ) || ( smpi->getRank() == smpi->getSize()-1 );
+    
+    string checkpoint_dir = Tools::merge( "checkpoints", PATH_SEPARATOR );
+    std::string dumpName = dumpFileName( checkpoint_dir, num_dump, file_index, number_of_files, file_grouping );
+    
+    current_dump = num_dump;
+    current_checkpoint_dir = checkpoint_dir;
+    current_file_index = file_index;
+    current_number_of_files = number_of_files;
+    if( dump_incremental ) {
+        // Previous dumps must be complete before deciding which ones are still needed
+        waitDump();
+        removeUnreferencedDumps();
+        dump_references[current_dump].clear();
     }
     
-    nameDumpTmp << "dump-" << setfill( '0' ) << setw( 5 ) << num_dump << "-" << setfill( '0' ) << setw( 10 ) << smpi->getRank() << ".h5" ;
-    std::string dumpName=nameDumpTmp.str();
+    int token = 0;
+    if( ! first_in_file ) {
+        MPI_Status status;
+        MPI_Recv( &token, 1, MPI_INT, smpi->getRank()-1, SMILEI_COMM_DUMP_TOKEN, smpi->SMILEI_COMM_WORLD, &status );
+    }
     
+    // With a staging directory, the dump is written locally, unless there is not enough room
+    string stagedName = "";
+    if( staging_dir != "" ) {
+        // The previous dump must have left the staging directory
+        waitDump();
+        if( stagingHasRoom( vecPatches ) ) {
+            size_t sep = dumpName.rfind( PATH_SEPARATOR );
+            stagedName = Tools::merge( staging_dir, PATH_SEPARATOR, dumpName.substr( sep+1 ) );
+        } else {
+            MESSAGEALL( "Not enough room in " << staging_dir << ": dump written directly to " << dumpName );
+        }
+    }
     
-    hid_t fid = H5Fcreate( dumpName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT );
+    hid_t fid, fapl = H5P_DEFAULT;
+    if( stagedName != "" ) {
+        fid = H5Fcreate( stagedName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT );
+    } else if( dump_async ) {
+        // The previous image must be on disk before it is replaced
+        waitDump();
+        // The file is built in memory (core driver without backing store)
+        fapl = H5Pcreate( H5P_FILE_ACCESS );
+        H5Pset_fapl_core( fapl, 64*1024*1024, 0 );
+        fid = H5Fcreate( dumpName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl );
+    } else if( first_in_file ) {
+        fid = H5Fcreate( dumpName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT );
+    } else {
+        fid = H5Fopen( dumpName.c_str(), H5F_ACC_RDWR, H5P_DEFAULT );
+    }
     if (fid<0) {
         ERROR("Can't open file for writing checkpoint " << dumpName.c_str())
     } else {
@@ -244,46 +344,55 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMP
 #endif
     
     
-    // Write basic attributes
-    H5::attr( fid, "Version", string( __VERSION ) );
-    
-    H5::attr( fid, "dump_step", itime );
-    H5::attr( fid, "dump_number", dump_number );
-    
-    H5::vect( fid, "patch_count", smpi->patch_count );
-    
-    // Write diags scalar data
-    DiagnosticScalar *scalars = static_cast<DiagnosticScalar *>( vecPatches.globalDiags[0] );
-    H5::attr( fid, "latest_timestep",   scalars->latest_timestep );
-    // Scalars only by master
-    if( smpi->isMaster() ) {
-        H5::attr( fid, "Energy_time_zero",  scalars->Energy_time_zero );
-        H5::attr( fid, "EnergyUsedForNorm", scalars->EnergyUsedForNorm );
-        // Poynting scalars
-        unsigned int k=0;
-        for( unsigned int j=0; j<2; j++ ) { //directions (xmin/xmax, ymin/ymax, zmin/zmax)
-            for( unsigned int i=0; i<params.nDim_field; i++ ) { //axis 0=x, 1=y, 2=z
-                if( scalars->necessary_poy[k] ) {
-                    string poy_name = Tools::merge( "Poy", Tools::xyz[i], j==0?"min":"max" );
-                    H5::attr( fid, poy_name, ( double )*( scalars->poy[k] ) );
-                    k++;
+    // Write basic attributes (once per file)
+    if( first_in_file ) {
+        H5::attr( fid, "Version", string( __VERSION ) );
+        
+        H5::attr( fid, "dump_step", itime );
+        H5::attr( fid, "dump_number", dump_number );
+        
+        H5::vect( fid, "patch_count", smpi->patch_count );
+        H5::attr( fid, "ranks_per_file", ranks_per_file );
+        H5::attr( fid, "file_grouping", file_grouping );
+        
+        // Write diags scalar data
+        DiagnosticScalar *scalars = static_cast<DiagnosticScalar *>( vecPatches.globalDiags[0] );
+        H5::attr( fid, "latest_timestep",   scalars->latest_timestep );
+        // Scalars only by master
+        if( smpi->isMaster() ) {
+            H5::attr( fid, "Energy_time_zero",  scalars->Energy_time_zero );
+            H5::attr( fid, "EnergyUsedForNorm", scalars->EnergyUsedForNorm );
+            // Poynting scalars
+            unsigned int k=0;
+            for( unsigned int j=0; j<2; j++ ) { //directions (xmin/xmax, ymin/ymax, zmin/zmax)
+                for( unsigned int i=0; i<params.nDim_field; i++ ) { //axis 0=x, 1=y, 2=z
+                    if( scalars->necessary_poy[k] ) {
+                        string poy_name = Tools::merge( "Poy", Tools::xyz[i], j==0?"min":"max" );
+                        H5::attr( fid, poy_name, ( double )*( scalars->poy[k] ) );
+                        k++;
+                    }
                 }
             }
         }
-    }
-    
-    // Write the diags screen data
-    ostringstream diagName( "" );
-    if( smpi->isMaster() ) {
-        unsigned int iscreen = 0;
-        for( unsigned int idiag=0; idiag<vecPatches.globalDiags.size(); idiag++ ) {
-            if( DiagnosticScreen *screen = dynamic_cast<DiagnosticScreen *>( vecPatches.globalDiags[idiag] ) ) {
-                diagName.str( "" );
-                diagName << "DiagScreen" << iscreen;
-                H5::vect( fid, diagName.str(), *(screen->getData()) );
-                iscreen++;
+        
+        // Write the diags screen data
+        ostringstream diagName( "" );
+        if( smpi->isMaster() ) {
+            unsigned int iscreen = 0;
+            for( unsigned int idiag=0; idiag<vecPatches.globalDiags.size(); idiag++ ) {
+                if( DiagnosticScreen *screen = dynamic_cast<DiagnosticScreen *>( vecPatches.globalDiags[idiag] ) ) {
+                    diagName.str( "" );
+                    diagName << "DiagScreen" << iscreen;
+                    H5::vect( fid, diagName.str(), *(screen->getData()) );
+                    iscreen++;
+                }
             }
         }
+        
+        // Write the moving window status
+        if( simWin!=NULL ) {
+            dumpMovingWindow( fid, simWin );
+        }
     }
     
     // Write all the patch data
@@ -297,26 +406,34 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMP
         
         dumpPatch( vecPatches( ipatch )->EMfields, vecPatches( ipatch )->vecSpecies, vecPatches( ipatch )->vecCollisions, params, patch_gid );
         
-        // Random number generator state
-        H5::attr( patch_gid, "xorshift32_state", vecPatches( ipatch )->rand_->xorshift32_state );
-        
         // Close a group
         H5Gclose( patch_gid );
         
     }
     
     // Write the latest Id that the MPI processes have given to each species
+    ostringstream rank_name( "" );
+    rank_name << "rank-" << setfill( '0' ) << setw( 10 ) << smpi->getRank();
+    hid_t rank_gid = H5::group( fid, rank_name.str() );
     for( unsigned int idiag=0; idiag<vecPatches.localDiags.size(); idiag++ ) {
         if( DiagnosticTrack *track = dynamic_cast<DiagnosticTrack *>( vecPatches.localDiags[idiag] ) ) {
             ostringstream n( "" );
             n<< "latest_ID_" << vecPatches( 0 )->vecSpecies[track->speciesId_]->name_;
-            H5::attr( fid, n.str().c_str(), track->latest_Id, H5T_NATIVE_UINT64 );
+            H5::attr( rank_gid, n.str().c_str(), track->latest_Id, H5T_NATIVE_UINT64 );
         }
     }
+    H5Gclose( rank_gid );
     
-    // Write the moving window status
-    if( simWin!=NULL ) {
-        dumpMovingWindow( fid, simWin );
+    if( dump_async ) {
+        // Copy the file image so that computation can resume while it is written
+        H5Fflush( fid, H5F_SCOPE_GLOBAL );
+        ssize_t image_size = H5Fget_file_image( fid, NULL, 0 );
+        if( image_size < 0 ) {
+            ERROR( "Can't get the image of checkpoint " << dumpName.c_str() );
+        }
+        dump_image.resize( image_size );
+        H5Fget_file_image( fid, &dump_image[0], image_size );
+        H5Pclose( fapl );
     }
     
     herr_t tclose = H5Fclose( fid );
@@ -324,6 +441,180 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMP
         ERROR("Can't close file " << dumpName.c_str())
     }
     
+    if( dump_async || stagedName != "" ) {
+        dump_thread = std::thread( drainDump, &dump_image, stagedName, dumpName, &dump_thread_failed );
+    }
+    
+    if( ! last_in_file ) {
+        MPI_Send( &token, 1, MPI_INT, smpi->getRank()+1, SMILEI_COMM_DUMP_TOKEN, smpi->SMILEI_COMM_WORLD );
+    }
+    
+}
+
+void Checkpoint::drainDump( std::vector<char> *image, std::string staged_file, std::string file_name, bool *failed )
+{
+    // The dump only gets its final name once complete, so that a partially
+    // written file is never picked for restart
+    string tmp_name = file_name + ".tmp";
+    FILE *f = fopen( tmp_name.c_str(), "wb" );
+    bool ok = ( f != NULL );
+    if( ok && staged_file != "" ) {
+        FILE *fs = fopen( staged_file.c_str(), "rb" );
+        ok = ( fs != NULL );
+        if( ok ) {
+            std::vector<char> buffer( 4*1024*1024 );
+            size_t n;
+            while( ok && ( n = fread( &buffer[0], 1, buffer.size(), fs ) ) > 0 ) {
+                ok = ( fwrite( &buffer[0], 1, n, f ) == n );
+            }
+            ok = ( ferror( fs ) == 0 ) && ok;
+            fclose( fs );
+        }
+    } else if( ok ) {
+        ok = ( fwrite( &( *image )[0], 1, image->size(), f ) == image->size() );
+    }
+    if( f != NULL ) {
+        ok = ( fflush( f ) == 0 ) && ok;
+        ok = ( fsync( fileno( f ) ) == 0 ) && ok;
+        ok = ( fclose( f ) == 0 ) && ok;
+    }
+    if( ok ) {
+        ok = ( rename( tmp_name.c_str(), file_name.c_str() ) == 0 );
+    }
+    if( ok && staged_file != "" ) {
+        remove( staged_file.c_str() );
+    }
+    *failed = !ok;
+    std::vector<char>().swap( *image );
+}
+
+bool Checkpoint::stagingHasRoom( VectorPatch &vecPatches )
+{
+    // Rough size of the dump: main fields and particle arrays
+    uint64_t expected = 0;
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size(); ipatch++ ) {
+        ElectroMagn *EMfields = vecPatches( ipatch )->EMfields;
+        if( EMfields->Ex_ ) {
+            expected += 9 * ( uint64_t )EMfields->Ex_->globalDims_ * sizeof( double );
+        }
+        for( unsigned int ispec=0 ; ispec<vecPatches( ipatch )->vecSpecies.size() ; ispec++ ) {
+            Particles *p = vecPatches( ipatch )->vecSpecies[ispec]->particles;
+            expected += ( uint64_t )p->size() * ( ( p->Position.size() + p->Momentum.size() + 1 ) * sizeof( double ) + sizeof( short ) + sizeof( uint64_t ) );
+        }
+    }
+    
+    struct statvfs stat;
+    if( statvfs( staging_dir.c_str(), &stat ) != 0 ) {
+        return false;
+    }
+    uint64_t available = ( uint64_t )stat.f_bavail * ( uint64_t )stat.f_frsize;
+    return available > expected + expected/10;
+}
+
+void Checkpoint::waitDump()
+{
+    if( dump_thread.joinable() ) {
+        dump_thread.join();
+        if( dump_thread_failed ) {
+            ERROR( "Background write of the last checkpoint failed" );
+        }
+    }
+}
+
+template<typename T>
+void Checkpoint::dumpVect( hid_t gid, std::string name, std::vector<T> &v, hid_t type, int deflate )
+{
+    if( linkToPreviousDump( gid, name, &v[0], v.size()*sizeof( T ) ) ) {
+        return;
+    }
+    H5::vect( gid, name, v[0], v.size(), type, deflate );
+}
+
+bool Checkpoint::linkToPreviousDump( hid_t gid, std::string name, const void *data, uint64_t bytes )
+{
+    if( ! dump_incremental ) {
+        return false;
+    }
+    
+    // Full path of the dataset, identical in all dumps
+    char group_path[1024];
+    H5Iget_name( gid, group_path, 1024 );
+    string path = Tools::merge( string( group_path ), "/", name );
+    
+    uint64_t hash = hashData( data, bytes );
+    std::map<std::string, DumpedData>::iterator it = dumped_data.find( path );
+    if( it != dumped_data.end() && it->second.hash == hash && it->second.bytes == bytes && it->second.dump != current_dump ) {
+        // Link target is relative to the directory of the current dump, where the previous dump also is
+        string target = dumpFileName( "", it->second.dump, current_file_index, current_number_of_files, 0 );
+        H5Lcreate_external( target.c_str(), path.c_str(), gid, name.c_str(), H5P_DEFAULT, H5P_DEFAULT );
+        dump_references[current_dump].insert( it->second.dump );
+        return true;
+    }
+    
+    DumpedData d = { hash, bytes, current_dump };
+    dumped_data[path] = d;
+    return false;
+}
+
+void Checkpoint::removeUnreferencedDumps()
+{
+    // Keep the keep_n_dumps-1 latest dumps (the current one makes keep_n_dumps) and those they link to
+    std::set<unsigned int> needed;
+    for( std::map<unsigned int, std::set<unsigned int> >::iterator it = dump_references.begin(); it != dump_references.end(); it++ ) {
+        if( it->first + keep_n_dumps > current_dump ) {
+            needed.insert( it->first );
+            needed.insert( it->second.begin(), it->second.end() );
+        }
+    }
+    
+    std::map<unsigned int, std::set<unsigned int> >::iterator it = dump_references.begin();
+    while( it != dump_references.end() ) {
+        if( needed.count( it->first ) == 0 ) {
+            string name = dumpFileName( current_checkpoint_dir, it->first, current_file_index, current_number_of_files, file_grouping );
+            remove( name.c_str() );
+            dump_references.erase( it++ );
+        } else {
+            it++;
+        }
+    }
+    
+    // Data held by deleted dumps cannot be linked to anymore
+    std::map<std::string, DumpedData>::iterator id = dumped_data.begin();
+    while( id != dumped_data.end() ) {
+        if( dump_references.count( id->second.dump ) == 0 ) {
+            dumped_data.erase( id++ );
+        } else {
+            id++;
+        }
+    }
+}
+
+uint64_t Checkpoint::hashData( const void *data, uint64_t bytes )
+{
+    // FNV-1a applied on 64-bit words
+    const unsigned char *c = static_cast<const unsigned char *>( data );
+    uint64_t hash = 14695981039346656037ULL ^ bytes;
+    uint64_t nwords = bytes / 8;
+    for( uint64_t i=0; i<nwords; i++ ) {
+        uint64_t word;
+        memcpy( &word, c + 8*i, 8 );
+        hash = ( hash ^ word ) * 1099511628211ULL;
+    }
+    for( uint64_t i=8*nwords; i<bytes; i++ ) {
+        hash = ( hash ^ c[i] ) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::string Checkpoint::dumpFileName( std::string checkpoint_dir, unsigned int num_dump, unsigned int file_index, unsigned int number_of_files, unsigned int grouping )
+{
+    ostringstream nameDumpTmp( "" );
+    nameDumpTmp << checkpoint_dir;
+    if( grouping>0 ) {
+        nameDumpTmp << setfill( '0' ) << setw( int( 1+log10( number_of_files/grouping+1 ) ) ) << file_index/grouping << PATH_SEPARATOR;
+    }
+    nameDumpTmp << "dump-" << setfill( '0' ) << setw( 5 ) << num_dump << "-" << setfill( '0' ) << setw( 10 ) << file_index << ".h5" ;
+    return nameDumpTmp.str();
 }
 
 void Checkpoint::dumpPatch( ElectroMagn *EMfields, std::vector<Species *> vecSpecies, std::vector<Collisions *> &vecCollisions, Params &params, hid_t patch_gid )
@@ -464,25 +755,25 @@ void Checkpoint::dumpPatch( ElectroMagn *EMfields, std::vector<Species *> vecSpe
             for( unsigned int i=0; i<vecSpecies[ispec]->particles->Position.size(); i++ ) {
                 ostringstream my_name( "" );
                 my_name << "Position-" << i;
-                H5::vect( gid, my_name.str(), vecSpecies[ispec]->particles->Position[i], dump_deflate );
+                dumpVect( gid, my_name.str(), vecSpecies[ispec]->particles->Position[i], H5T_NATIVE_DOUBLE, dump_deflate );
             }
             
             for( unsigned int i=0; i<vecSpecies[ispec]->particles->Momentum.size(); i++ ) {
                 ostringstream my_name( "" );
                 my_name << "Momentum-" << i;
-                H5::vect( gid, my_name.str(), vecSpecies[ispec]->particles->Momentum[i], dump_deflate );
+                dumpVect( gid, my_name.str(), vecSpecies[ispec]->particles->Momentum[i], H5T_NATIVE_DOUBLE, dump_deflate );
             }
             
-            H5::vect( gid, "Weight", vecSpecies[ispec]->particles->Weight, dump_deflate );
-            H5::vect( gid, "Charge", vecSpecies[ispec]->particles->Charge, dump_deflate );
+            dumpVect( gid, "Weight", vecSpecies[ispec]->particles->Weight, H5T_NATIVE_DOUBLE, dump_deflate );
+            dumpVect( gid, "Charge", vecSpecies[ispec]->particles->Charge, H5T_NATIVE_SHORT, dump_deflate );
             
             if( vecSpecies[ispec]->particles->tracked ) {
-                H5::vect( gid, "Id", vecSpecies[ispec]->particles->Id, H5T_NATIVE_UINT64, dump_deflate );
+                dumpVect( gid, "Id", vecSpecies[ispec]->particles->Id, H5T_NATIVE_UINT64, dump_deflate );
             }
             
             
-            H5::vect( gid, "first_index", vecSpecies[ispec]->particles->first_index );
-            H5::vect( gid, "last_index", vecSpecies[ispec]->particles->last_index );
+            dumpVect( gid, "first_index", vecSpecies[ispec]->particles->first_index, H5T_NATIVE_INT );
+            dumpVect( gid, "last_index", vecSpecies[ispec]->particles->last_index, H5T_NATIVE_INT );
             
         } // End if partSize
         
@@ -529,7 +820,7 @@ void Checkpoint::dumpPatch( ElectroMagn *EMfields, std::vector<Species *> vecSpe
 
 void Checkpoint::readPatchDistribution( SmileiMPI *smpi, SimWindow *simWin )
 {
-    hid_t fid = H5Fopen( restart_file.c_str(), H5F_ACC_RDWR, H5P_DEFAULT );
+    hid_t fid = H5Fopen( restart_file.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT );
     if( fid < 0 ) {
         ERROR( restart_file << " is not a valid HDF5 file" );
     }
@@ -546,9 +837,40 @@ void Checkpoint::readPatchDistribution( SmileiMPI *smpi, SimWindow *simWin )
         WARNING( "                while running version is " << string( __VERSION ) );
     }
     
-    vector<int> patch_count( smpi->getSize() );
-    H5::getVect( fid, "patch_count", patch_count );
-    smpi->patch_count = patch_count;
+    // Layout of the dump, which may have been written with a different number of ranks
+    H5::getVect( fid, "patch_count", restart_patch_count, true );
+    restart_ranks_per_file = 1;
+    if( H5::hasAttr( fid, "ranks_per_file" ) ) {
+        H5::getAttr( fid, "ranks_per_file", restart_ranks_per_file );
+    }
+    restart_file_grouping = file_grouping;
+    if( H5::hasAttr( fid, "file_grouping" ) ) {
+        H5::getAttr( fid, "file_grouping", restart_file_grouping );
+    }
+    
+    // Recover the checkpoint directory, dump number and file index from the file name
+    size_t sep = restart_file.rfind( PATH_SEPARATOR );
+    string restart_file_name = ( sep == string::npos ) ? restart_file : restart_file.substr( sep+1 );
+    restart_checkpoint_dir = ( sep == string::npos ) ? "" : restart_file.substr( 0, sep+1 );
+    if( restart_file_grouping > 0 && restart_checkpoint_dir.size() > 1 ) {
+        size_t sep_group = restart_checkpoint_dir.rfind( PATH_SEPARATOR, restart_checkpoint_dir.size()-2 );
+        restart_checkpoint_dir = ( sep_group == string::npos ) ? "" : restart_checkpoint_dir.substr( 0, sep_group+1 );
+    }
+    if( sscanf( restart_file_name.c_str(), "dump-%u-%u.h5", &restart_num_dump, &restart_file_index ) != 2 ) {
+        ERROR( "Restart file " << restart_file << " does not follow the checkpoint naming `dump-XXXXX-XXXXXXXXXX.h5`" );
+    }
+    
+    if( restart_patch_count.size() == ( unsigned int ) smpi->getSize() ) {
+        smpi->patch_count = restart_patch_count;
+    } else {
+        // Different number of ranks: patches are distributed evenly (load balancing may refine this later)
+        // and each of them will be read from whichever file contains it
+        int total_patches = accumulate( restart_patch_count.begin(), restart_patch_count.end(), 0 );
+        for( int rk=0 ; rk<smpi->getSize() ; rk++ ) {
+            smpi->patch_count[rk] = total_patches / smpi->getSize() + ( rk < total_patches % smpi->getSize() ? 1 : 0 );
+        }
+        MESSAGE( 1, "Redistributing the patches of " << restart_patch_count.size() << " ranks over " << smpi->getSize() << " ranks" );
+    }
     
     smpi->patch_refHindexes.resize( smpi->patch_count.size(), 0 );
     smpi->patch_refHindexes[0] = 0;
@@ -567,7 +889,7 @@ void Checkpoint::restartAll( VectorPatch &vecPatches,  SmileiMPI *smpi, SimWindo
 {
     MESSAGE( 1, "READING fields and particles for restart" );
     
-    hid_t fid = H5Fopen( restart_file.c_str(), H5F_ACC_RDWR, H5P_DEFAULT );
+    hid_t fid = H5Fopen( restart_file.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT );
     if( fid < 0 ) {
         ERROR( restart_file << " is not a valid HDF5 file" );
     }
@@ -613,39 +935,105 @@ void Checkpoint::restartAll( VectorPatch &vecPatches,  SmileiMPI *smpi, SimWindo
     }
     
     // Read all the patch data
+    // Patches are looked for in the file which contains them in the previous run's layout
+    unsigned int number_of_files = ( restart_patch_count.size()-1 ) / restart_ranks_per_file + 1;
+    hid_t patch_fid = fid;
+    unsigned int patch_file_index = restart_file_index;
     for( unsigned int ipatch=0 ; ipatch<vecPatches.size(); ipatch++ ) {
     
+        unsigned int file_index = restartFileIndexOfPatch( vecPatches( ipatch )->Hindex() );
+        if( file_index != patch_file_index ) {
+            if( patch_fid != fid ) {
+                H5Fclose( patch_fid );
+            }
+            if( file_index == restart_file_index ) {
+                patch_fid = fid;
+            } else {
+                string patch_file = dumpFileName( restart_checkpoint_dir, restart_num_dump, file_index, number_of_files, restart_file_grouping );
+                patch_fid = H5Fopen( patch_file.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT );
+                if( patch_fid < 0 ) {
+                    ERROR( patch_file << " is not a valid HDF5 file" );
+                }
+            }
+            patch_file_index = file_index;
+        }
+        
         ostringstream patch_name( "" );
         patch_name << setfill( '0' ) << setw( 6 ) << vecPatches( ipatch )->Hindex();
         string patchName=Tools::merge( "patch-", patch_name.str() );
-        hid_t patch_gid = H5Gopen( fid, patchName.c_str(), H5P_DEFAULT );
+        hid_t patch_gid = H5Gopen( patch_fid, patchName.c_str(), H5P_DEFAULT );
+        if( patch_gid < 0 ) {
+            ERROR( "Cannot find " << patchName << " in checkpoint file " << file_index );
+        }
         
         restartPatch( vecPatches( ipatch )->EMfields, vecPatches( ipatch )->vecSpecies, vecPatches( ipatch )->vecCollisions, params, patch_gid );
         
-        // Random number generator state
-        H5::getAttr( patch_gid, "xorshift32_state", vecPatches( ipatch )->rand_->xorshift32_state );
-        
         H5Gclose( patch_gid );
         
     }
+    if( patch_fid != fid ) {
+        H5Fclose( patch_fid );
+    }
     
     // Read the latest Id that the MPI processes have given to each species
+    // They are stored in the group of the same rank in the previous run (or at the file root for older dumps)
+    hid_t rank_fid = -1, rank_gid = -1;
+    if( smpi->getRank() < ( int ) restart_patch_count.size() ) {
+        unsigned int rank_file_index = restartFileIndexOfRank( smpi->getRank() );
+        if( rank_file_index == restart_file_index ) {
+            rank_fid = fid;
+        } else {
+            string rank_file = dumpFileName( restart_checkpoint_dir, restart_num_dump, rank_file_index, number_of_files, restart_file_grouping );
+            rank_fid = H5Fopen( rank_file.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT );
+        }
+        ostringstream rank_name( "" );
+        rank_name << "rank-" << setfill( '0' ) << setw( 10 ) << smpi->getRank();
+        if( rank_fid >= 0 && H5Lexists( rank_fid, rank_name.str().c_str(), H5P_DEFAULT ) > 0 ) {
+            rank_gid = H5Gopen( rank_fid, rank_name.str().c_str(), H5P_DEFAULT );
+        } else {
+            rank_gid = rank_fid;
+        }
+    }
     for( unsigned int idiag=0; idiag<vecPatches.localDiags.size(); idiag++ ) {
         if( DiagnosticTrack *track = dynamic_cast<DiagnosticTrack *>( vecPatches.localDiags[idiag] ) ) {
             ostringstream n( "" );
             n<< "latest_ID_" << vecPatches( 0 )->vecSpecies[track->speciesId_]->name_;
-            if( H5::hasAttr( fid, n.str() ) ) {
-                H5::getAttr( fid, n.str(), track->latest_Id, H5T_NATIVE_UINT64 );
+            if( rank_gid >= 0 && H5::hasAttr( rank_gid, n.str() ) ) {
+                H5::getAttr( rank_gid, n.str(), track->latest_Id, H5T_NATIVE_UINT64 );
             } else {
                 track->IDs_done=false;
             }
         }
     }
+    if( rank_gid >= 0 && rank_gid != rank_fid ) {
+        H5Gclose( rank_gid );
+    }
+    if( rank_fid >= 0 && rank_fid != fid ) {
+        H5Fclose( rank_fid );
+    }
     
     H5Fclose( fid );
     
 }
 
+unsigned int Checkpoint::restartFileIndexOfPatch( unsigned int hindex )
+{
+    unsigned int first_hindex = 0;
+    for( unsigned int rk=0 ; rk<restart_patch_count.size() ; rk++ ) {
+        first_hindex += restart_patch_count[rk];
+        if( hindex < first_hindex ) {
+            return restartFileIndexOfRank( rk );
+        }
+    }
+    ERROR( "Patch " << hindex << " not found in the checkpoint" );
+    return 0;
+}
+
+unsigned int Checkpoint::restartFileIndexOfRank( unsigned int rank )
+{
+    return rank / restart_ranks_per_file;
+}
+
 
 void Checkpoint::restartPatch( ElectroMagn *EMfields, std::vector<Species *> &vecSpecies, std::vector<Collisions *> &vecCollisions, Params &params, hid_t patch_gid )
 {
@@ -882,6 +1270,9 @@ void Checkpoint::restartPatch( ElectroMagn *EMfields, std::vector<Species *> &ve
 
 void Checkpoint::dumpFieldsPerProc( hid_t fid, Field *field )
 {
+    if( linkToPreviousDump( fid, field->name, &field->data_[0], field->globalDims_*sizeof( double ) ) ) {
+        return;
+    }
     hsize_t dims[1]= {field->globalDims_};
     hid_t sid = H5Screate_simple( 1, dims, NULL );
     hid_t did = H5Dcreate( fid, field->name.c_str(), H5T_NATIVE_DOUBLE, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT );
@@ -893,6 +1284,9 @@ void Checkpoint::dumpFieldsPerProc( hid_t fid, Field *field )
 void Checkpoint::dump_cFieldsPerProc( hid_t fid, Field *field )
 {
     cField *cfield = static_cast<cField *>( field );
+    if( linkToPreviousDump( fid, field->name, &cfield->cdata_[0], 2*field->globalDims_*sizeof( double ) ) ) {
+        return;
+    }
     hsize_t dims[1]= {2*field->globalDims_}; //*2 : to manage complex data
     hid_t sid = H5Screate_simple( 1, dims, NULL );
     hid_t did = H5Dcreate( fid, field->name.c_str(), H5T_NATIVE_DOUBLE, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT );
@@ -9,6 +9,10 @@
 
 #include <string>
 #include <vector>
+#include <map>
+#include <set>
+#include <thread>
+#include <cstdint>
 
 #include <hdf5.h>
 #include <Tools.h>
@@ -35,7 +39,7 @@ class Checkpoint
 public:
     Checkpoint( Params &params, SmileiMPI *smpi );
     //! Destructor for Checkpoint
-    virtual ~Checkpoint() {};
+    virtual ~Checkpoint();
     
     //! Space dimension of a particle
     unsigned int nDim_particle;
@@ -45,6 +49,10 @@ public:
     void restartAll( VectorPatch &vecPatches,  SmileiMPI *smpi, SimWindow *simWin, Params &params, OpenPMDparams &openPMD );
     void restartPatch( ElectroMagn *EMfields, std::vector<Species *> &vecSpecies, std::vector<Collisions *> &vecCollisions, Params &params, hid_t patch_gid );
     
+    //! index of the file of the previous run which contains a given patch (or rank)
+    unsigned int restartFileIndexOfPatch( unsigned int hindex );
+    unsigned int restartFileIndexOfRank( unsigned int rank );
+    
     //! restart field per proc
     void restartFieldsPerProc( hid_t fid, Field *field );
     void restart_cFieldsPerProc( hid_t fid, Field *field );
@@ -61,6 +69,9 @@ public:
     void dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMPI *smpi, SimWindow *simWin, Params &params );
     void dumpPatch( ElectroMagn *EMfields, std::vector<Species *> vecSpecies, std::vector<Collisions *> &vecCollisions, Params &params, hid_t patch_gid );
     
+    //! wait for the end of the background write of an asynchronous dump
+    void waitDump();
+    
     //! incremental number of times we've done a dump
     unsigned int dump_number;
     
@@ -132,6 +143,62 @@ private:
     //! int deflate dump value
     int dump_deflate;
     
+    //! dumps are first written in memory, then to disk by a background thread
+    bool dump_async;
+    
+    //! in-memory image of the file being written in the background
+    std::vector<char> dump_image;
+    
+    //! background thread writing dump_image to disk
+    std::thread dump_thread;
+    
+    //! set by the background thread if the image could not be written
+    bool dump_thread_failed;
+    
+    //! node-local directory where dumps are written before being copied in the background
+    std::string staging_dir;
+    
+    //! check that the staging directory can hold the next dump
+    bool stagingHasRoom( VectorPatch &vecPatches );
+    
+    //! write the in-memory image (or copy the staged file) to a temporary file, then rename it
+    static void drainDump( std::vector<char> *image, std::string staged_file, std::string file_name, bool *failed );
+    
+    //! datasets identical to those of a previous dump are replaced by links to that dump
+    bool dump_incremental;
+    
+    //! for each dataset path, the hash of its content and the dump which holds the data
+    struct DumpedData {
+        uint64_t hash;
+        uint64_t bytes;
+        unsigned int dump;
+    };
+    std::map<std::string, DumpedData> dumped_data;
+    
+    //! for each dump of this run still on disk, the dumps it links to
+    std::map<unsigned int, std::set<unsigned int> > dump_references;
+    
+    //! dump currently being written
+    unsigned int current_dump;
+    
+    //! directory and file index of the dumps of this run
+    std::string current_checkpoint_dir;
+    unsigned int current_file_index;
+    unsigned int current_number_of_files;
+    
+    //! link a dataset to a previous dump if its content did not change (returns false if it must be written)
+    bool linkToPreviousDump( hid_t gid, std::string name, const void *data, uint64_t bytes );
+    
+    //! write a vector, or link it to a previous dump in incremental mode
+    template<typename T>
+    void dumpVect( hid_t gid, std::string name, std::vector<T> &v, hid_t type, int deflate=0 );
+    
+    //! delete the dumps of this run that are neither recent nor referenced by recent dumps
+    void removeUnreferencedDumps();
+    
+    //! hash of a memory region
+    static uint64_t hashData( const void *data, uint64_t bytes );
+    
     std::vector<MPI_Request> dump_request;
     MPI_Status dump_status_prob;
     MPI_Status dump_status_recv;
@@ -139,9 +206,23 @@ private:
     //! group checkpoint files in subdirs of file_grouping files
     unsigned int file_grouping;
     
+    //! number of MPI ranks aggregated in each checkpoint file
+    unsigned int ranks_per_file;
+    
+    //! build the name of a checkpoint file from its dump number and file index
+    std::string dumpFileName( std::string checkpoint_dir, unsigned int num_dump, unsigned int file_index, unsigned int number_of_files, unsigned int grouping );
+    
     //! restart file
     std::string restart_file;
     
+    //! layout of the dump used for restart (may differ from the current run)
+    std::vector<int> restart_patch_count;
+    unsigned int restart_ranks_per_file;
+    unsigned int restart_file_grouping;
+    unsigned int restart_file_index;
+    unsigned int restart_num_dump;
+    std::string restart_checkpoint_dir;
+    
 };
 
 #endif /* CHECKPOINT_H_ */
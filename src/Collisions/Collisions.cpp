@@ -12,6 +12,10 @@
 #include "Patch.h"
 #include "VectorPatch.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 
 
@@ -24,6 +28,8 @@ Collisions::Collisions(
     double coulomb_log,
     bool intra_collisions,
     int debug_every,
+    double subcycling_threshold,
+    unsigned int subcycling_max,
     CollisionalIonization *ionization,
     CollisionalNuclearReaction *nuclear_reaction,
     string filename
@@ -36,10 +42,16 @@ Collisions::Collisions(
     coulomb_log_( coulomb_log ),
     intra_collisions_( intra_collisions ),
     debug_every_( debug_every ),
+    subcycling_threshold_( subcycling_threshold ),
+    subcycling_max_( subcycling_max ),
     filename_( filename )
 {
     coeff1_ = 4.046650232e-21*params.reference_angular_frequency_SI; // h*omega/(2*me*c^2)
     coeff2_ = 2.817940327e-15*params.reference_angular_frequency_SI/299792458.; // re omega / c
+    batched_ = dynamic_cast<CollisionalNoIonization *>( Ionization )
+               && dynamic_cast<CollisionalNoNuclearReaction *>( NuclearReaction );
+    debug_bins_ = false;
+    ncol_ = 0.;
 }
 
 
@@ -53,6 +65,8 @@ Collisions::Collisions( Collisions *coll )
     coulomb_log_      = coll->coulomb_log_     ;
     intra_collisions_ = coll->intra_collisions_;
     debug_every_      = coll->debug_every_     ;
+    subcycling_threshold_ = coll->subcycling_threshold_;
+    subcycling_max_   = coll->subcycling_max_  ;
     filename_         = coll->filename_        ;
     coeff1_           = coll->coeff1_        ;
     coeff2_           = coll->coeff2_        ;
@@ -68,6 +82,9 @@ Collisions::Collisions( Collisions *coll )
     } else if ( dynamic_cast<CollisionalFusionDD *>( coll->NuclearReaction ) ) {
         NuclearReaction = new CollisionalFusionDD( coll->NuclearReaction );
     }
+    batched_ = coll->batched_;
+    debug_bins_ = false;
+    ncol_ = 0.;
 }
 
 
@@ -79,6 +96,208 @@ Collisions::~Collisions()
 
 // Declare other static variables here
 bool   Collisions::debye_length_required;
+std::vector<Collisions::PairBatch> Collisions::batches_;
+
+void Collisions::allocate_batches()
+{
+#ifdef _OPENMP
+    batches_.resize( omp_get_max_threads() );
+#else
+    batches_.resize( 1 );
+#endif
+}
+
+void Collisions::prepare_bins( Patch *patch, int itime )
+{
+    // Bins start unknown, and are collided at their first timestep
+    if( subcycling_threshold_ > 0. && bin_s_rate_.size() == 0 ) {
+        unsigned int nbin = patch->vecSpecies[0]->particles->first_index.size();
+        bin_elapsed_steps_.resize( nbin, 0 );
+        bin_s_rate_.resize( nbin, -1. );
+    }
+    debug_bins_ = ( debug_every_ > 0 && itime % debug_every_ == 0 ); // debug only every N timesteps
+    ncol_        = 0.;
+    smean_       = 0.;
+    logLmean_    = 0.;
+}
+
+void Collisions::finish_bins()
+{
+    if( debug_bins_ && ncol_>0. ) {
+        smean_    /= ncol_;
+        logLmean_ /= ncol_;
+    }
+}
+
+// Lists the species and index of each particle of a group of species in one bin,
+// and returns the sum of their weights
+static double list_group_particles( Patch *patch, vector<unsigned int> &group, unsigned int ibin, vector<Particles *> &particles, vector<unsigned int> &index, vector<double> &mass )
+{
+    double density = 0.;
+    unsigned int ipart = 0;
+    for( unsigned int ispec=0 ; ispec<group.size() ; ispec++ ) {
+        Species *s = patch->vecSpecies[group[ispec]];
+        for( int i = s->particles->first_index[ibin]; i < s->particles->last_index[ibin]; i++, ipart++ ) {
+            particles[ipart] = s->particles;
+            index[ipart] = i;
+            mass[ipart] = s->mass_;
+            density += s->particles->weight( i );
+        }
+    }
+    return density;
+}
+
+// Collides the pairs of one bin by batches
+// The random numbers come from a stream which only depends on the patch, bin and iteration,
+// so that the result does not depend on which thread collides which bin
+void Collisions::collide_bin( Params &params, Patch *patch, int itime, unsigned int ibin )
+{
+    int ithread = 0;
+#ifdef _OPENMP
+    ithread = omp_get_thread_num();
+#endif
+    PairBatch &batch = batches_[ithread];
+    
+    // Sub-cycling: skip the bin while its expected collision parameter remains small
+    double elapsed_steps;
+    if( ! bin_collides_now( ibin, elapsed_steps ) ) {
+        return;
+    }
+    
+    Random rand( params.random_seed, patch->Hindex(), ( ( uint64_t ) n_collisions_ << 32 ) + ibin, itime );
+    
+    // get number of particles for all necessary species
+    vector<unsigned int> *sg1 = &species_group1_, *sg2 = &species_group2_;
+    unsigned int npart1 = 0, npart2 = 0;
+    for( unsigned int ispec1=0 ; ispec1<sg1->size() ; ispec1++ ) {
+        Species *s1 = patch->vecSpecies[( *sg1 )[ispec1]];
+        npart1 += s1->particles->last_index[ibin] - s1->particles->first_index[ibin];
+    }
+    for( unsigned int ispec2=0 ; ispec2<sg2->size() ; ispec2++ ) {
+        Species *s2 = patch->vecSpecies[( *sg2 )[ispec2]];
+        npart2 += s2->particles->last_index[ibin] - s2->particles->first_index[ibin];
+    }
+    // ensure group1 has more macro-particles
+    if( npart2 > npart1 ) {
+        swap( sg1, sg2 );
+        swap( npart1, npart2 );
+    }
+    
+    // skip if no particles
+    if( npart1==0 || npart2==0 || ( intra_collisions_ && npart1 < 2 ) ) {
+        return;
+    }
+    
+    double debye2 = 0.;
+    if( Collisions::debye_length_required ) {
+        debye2 = patch->debye_length_squared[ibin];
+    }
+    
+    // List the species and index of each particle of both groups, to avoid searching them for each pair
+    batch.group1_particles.resize( npart1 );
+    batch.group1_index.resize( npart1 );
+    batch.group1_mass.resize( npart1 );
+    batch.group2_particles.resize( npart2 );
+    batch.group2_index.resize( npart2 );
+    batch.group2_mass.resize( npart2 );
+    double n1 = list_group_particles( patch, *sg1, ibin, batch.group1_particles, batch.group1_index, batch.group1_mass );
+    double n2 = list_group_particles( patch, *sg2, ibin, batch.group2_particles, batch.group2_index, batch.group2_mass );
+    
+    // Shuffle particles to have random pairs
+    vector<unsigned int> &index1 = batch.index1, &index2 = batch.index2;
+    index1.resize( npart1 );
+    for( unsigned int i=0; i<npart1; i++ ) {
+        index1[i] = i;
+    }
+    for( unsigned int i=npart1; i>1; i-- ) {
+        unsigned int p = rand.integer() % i;
+        swap( index1[i-1], index1[p] );
+    }
+    unsigned int npairs, N2max;
+    if( intra_collisions_ ) { // In the case of collisions within one species
+        npairs = ( npart1 + 1 ) / 2; // half as many pairs as macro-particles
+        index2.resize( npairs );
+        for( unsigned int i=0; i<npairs; i++ ) {
+            index2[i] = index1[( i+npairs )%npart1];    // index2 is second half
+        }
+        index1.resize( npairs ); // index1 is first half
+        N2max = npart1 - npairs; // number of not-repeated particles (in group 2 only)
+    } else { // In the case of collisions between two species
+        npairs = npart1; // as many pairs as macro-particles in group 1 (most numerous)
+        index2.resize( npairs );
+        for( unsigned int i=0; i<npart1; i++ ) {
+            index2[i] = i % npart2;
+        }
+        N2max = npart2; // number of not-repeated particles (in group 2 only)
+    }
+    
+    // Pre-calculate some numbers before the big loop
+    Species *s1 = patch->vecSpecies[( *sg1 )[0]];
+    double inv_cell_volume = 1./patch->getPrimalCellVolume( s1->particles, s1->particles->first_index[ibin], params );
+    unsigned int ncorr = intra_collisions_ ? 2*npairs-1 : npairs;
+    double dt_corr = params.timestep * elapsed_steps * ((double)ncorr) * inv_cell_volume;
+    double coeff3 = coeff2_ * dt_corr;
+    double coeff4 = pow( 3.*coeff2_, -1./3. ) * dt_corr;
+    double weight_correction_1 = 1. / (double)( (npairs-1) / N2max );
+    double weight_correction_2 = 1. / (double)( (npairs-1) / N2max + 1 );
+    n1  *= inv_cell_volume;
+    n2  *= inv_cell_volume;
+    double n123 = pow( n1, 2./3. );
+    double n223 = pow( n2, 2./3. );
+    
+    // Particles of group 2 are repeated every N2max pairs: pairs are collided
+    // by batches of N2max so that a batch never contains the same particle twice
+    double smean = 0., logLmean = 0.;
+    for( unsigned int ipair0 = 0; ipair0<npairs; ipair0 += N2max ) {
+        unsigned int n = min( N2max, npairs - ipair0 );
+        batch.resize( n );
+        for( unsigned int k = 0; k<n; k++ ) {
+            unsigned int ipair = ipair0 + k;
+            unsigned int j1 = index1[ipair];
+            unsigned int j2 = index2[ipair];
+            Particles *p1 = batch.group1_particles[j1];
+            Particles *p2 = batch.group2_particles[j2];
+            unsigned int i1 = batch.group1_index[j1];
+            unsigned int i2 = batch.group2_index[j2];
+            
+            double weight_correction = std::max( p1->weight( i1 ), p2->weight( i2 ) );
+            if( ipair % N2max <= ( npairs-1 ) % N2max ) {
+                weight_correction *= weight_correction_2 ;
+            } else {
+                weight_correction *= weight_correction_1;
+            }
+            gather_pair( batch, k, p1, i1, batch.group1_mass[j1], p2, i2, batch.group2_mass[j2], weight_correction );
+            
+            batch.U1 [k] = rand.uniform();
+            batch.U2 [k] = rand.uniform();
+            batch.phi[k] = rand.uniform_2pi();
+        }
+        
+        collide_batch( batch, n, coeff3, coeff4, n123, n223, debye2 );
+        scatter_batch( batch, n );
+        
+        if( debug_bins_ || subcycling_threshold_ > 0. ) {
+            for( unsigned int k = 0; k<n; k++ ) {
+                smean    += batch.s[k];
+                logLmean += batch.logL[k];
+            }
+        }
+    }
+    
+    // Collision parameter per timestep, to decide when this bin will be collided again
+    if( subcycling_threshold_ > 0. ) {
+        bin_s_rate_[ibin] = smean / ( npairs * elapsed_steps );
+    }
+    
+    if( debug_bins_ ) {
+        #pragma omp atomic
+        ncol_ += npairs;
+        #pragma omp atomic
+        smean_ += smean;
+        #pragma omp atomic
+        logLmean_ += logLmean;
+    }
+}
 
 
 // Calculates the debye length squared in each patch
@@ -168,6 +387,16 @@ void Collisions::calculate_debye_length( Params &params, Patch *patch )
 // Calculates the collisions for a given Collisions object
 void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagnostic *> &localDiags )
 {
+    // Collide the bins independently when possible
+    if( batched_ ) {
+        prepare_bins( patch, itime );
+        unsigned int nbin = patch->vecSpecies[0]->particles->first_index.size();
+        for( unsigned int ibin = 0 ; ibin < nbin ; ibin++ ) {
+            collide_bin( params, patch, itime, ibin );
+        }
+        finish_bins();
+        return;
+    }
 
     vector<unsigned int> *sg1, *sg2, index1, index2;
     unsigned int nspec1, nspec2; // numbers of species in each group
@@ -361,6 +590,116 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
 }
 
 
+// Collides all pairs gathered in the batch
+// Same equations as one_collision (see http://dx.doi.org/10.1063/1.4742167), without nuclear reactions.
+// Branches are replaced by selections so that the loop can be vectorized.
+void Collisions::collide_batch( PairBatch &batch, unsigned int n, double coeff3, double coeff4, double n123, double n223, double debye2 )
+{
+    double *px1 = &batch.px1[0], *py1 = &batch.py1[0], *pz1 = &batch.pz1[0];
+    double *px2 = &batch.px2[0], *py2 = &batch.py2[0], *pz2 = &batch.pz2[0];
+    double *m1 = &batch.m1[0], *m2 = &batch.m2[0], *q1 = &batch.q1[0], *q2 = &batch.q2[0];
+    double *w1 = &batch.w1[0], *w2 = &batch.w2[0], *weight_correction = &batch.weight_correction[0];
+    double *U1 = &batch.U1[0], *U2 = &batch.U2[0], *phi = &batch.phi[0];
+    double *s_out = &batch.s[0], *logL_out = &batch.logL[0];
+    double coeff1 = coeff1_, coulomb_log = coulomb_log_;
+    
+    #pragma omp simd
+    for( unsigned int k=0; k<n; k++ ) {
+        double m12 = m1[k] / m2[k];
+        
+        // If one weight is zero, then skip
+        bool active = std::min( w1[k], w2[k] ) > 0.;
+        
+        // Get momenta and calculate gammas
+        double gamma1 = sqrt( 1. + px1[k]*px1[k] + py1[k]*py1[k] + pz1[k]*pz1[k] );
+        double gamma2 = sqrt( 1. + px2[k]*px2[k] + py2[k]*py2[k] + pz2[k]*pz2[k] );
+        double gamma12_inv = 1./( m12 * gamma1 + gamma2 );
+        
+        // Calculate the center-of-mass (COM) frame
+        double COM_vx = ( m12 * px1[k] + px2[k] ) * gamma12_inv;
+        double COM_vy = ( m12 * py1[k] + py2[k] ) * gamma12_inv;
+        double COM_vz = ( m12 * pz1[k] + pz2[k] ) * gamma12_inv;
+        double COM_vsquare = COM_vx*COM_vx + COM_vy*COM_vy + COM_vz*COM_vz;
+        
+        // Change the momentum to the COM frame (we work only on particle 1)
+        // When COM_vsquare is zero, these formulae reduce to the identity, except term1
+        double COM_gamma = 1./sqrt( 1.-COM_vsquare );
+        double term1 = COM_vsquare != 0. ? ( COM_gamma - 1. ) / ( COM_vsquare != 0. ? COM_vsquare : 1. ) : 0.5;
+        double vcv1  = ( COM_vx*px1[k] + COM_vy*py1[k] + COM_vz*pz1[k] )/gamma1;
+        double vcv2  = ( COM_vx*px2[k] + COM_vy*py2[k] + COM_vz*pz2[k] )/gamma2;
+        double term2 = ( term1*vcv1 - COM_gamma ) * gamma1;
+        double px_COM = px1[k] + term2*COM_vx;
+        double py_COM = py1[k] + term2*COM_vy;
+        double pz_COM = pz1[k] + term2*COM_vz;
+        double gamma1_COM = ( 1.-vcv1 )*COM_gamma*gamma1;
+        double gamma2_COM = ( 1.-vcv2 )*COM_gamma*gamma2;
+        double p2_COM = px_COM*px_COM + py_COM*py_COM + pz_COM*pz_COM;
+        double p_COM  = sqrt( p2_COM );
+        
+        // Calculate some intermediate quantities
+        double term3 = COM_gamma * gamma12_inv;
+        double term4 = gamma1_COM * gamma2_COM;
+        double term5 = term4/p2_COM + m12;
+        double vrel = p_COM/term3/term4; // relative velocity
+        
+        double qqm  = q1[k] * q2[k] / m1[k];
+        double qqm2 = qqm * qqm;
+        
+        // Calculate coulomb log if necessary
+        double logL = coulomb_log;
+        if( logL <= 0. ) { // if auto-calculation requested
+            double bmin = coeff1 * std::max( 1./m1[k]/p_COM, std::abs( 0.00232282*qqm*term3*term5 ) ); // min impact parameter
+            logL = std::max( 0.5*log( 1.+debye2/( bmin*bmin ) ), 2. );
+        }
+        
+        // Calculate the collision parameter s12 (similar to number of real collisions)
+        double s = coeff3 * weight_correction[k] * logL * qqm2 * term3 * p_COM * term5*term5 / ( gamma1*gamma2 );
+        
+        // Low-temperature correction
+        double smax = coeff4 * weight_correction[k] * ( m12+1. ) * vrel / std::max( m12*n123, n223 );
+        s = std::min( s, smax );
+        
+        // Pick the deflection angles (Nanbu's technique, see one_collision)
+        double cosX_small = 1. + s*log( std::max( U1[k], 0.0001 ) );
+        double invA_poly = 0.00569578 +( 0.95602 + ( -0.508139 + ( 0.479139 + ( -0.12789 + 0.0238957*s )*s )*s )*s )*s;
+        double A_exp = 3.*exp( -s );
+        double A    = s < 3. ? 1./invA_poly : A_exp;
+        double invA = s < 3. ? invA_poly : 1./A_exp;
+        double cosX_mid = invA * log( exp( -A ) + 2.*U1[k]*sinh( A ) );
+        double cosX = s < 0.1 ? cosX_small : ( s < 6. ? cosX_mid : 2.*U1[k] - 1. );
+        double sinX = sqrt( 1. - cosX*cosX );
+        
+        // Calculate combination of angles
+        double sinXcosPhi = sinX*cos( phi[k] );
+        double sinXsinPhi = sinX*sin( phi[k] );
+        
+        // Apply the deflection
+        double p_perp = sqrt( px_COM*px_COM + py_COM*py_COM );
+        bool large_p_perp = p_perp > 1.e-10*p_COM; // if p_perp is too small, we use the limit px->0, py=0
+        double inv_p_perp = 1./( large_p_perp ? p_perp : 1. );
+        double newpx_COM = large_p_perp ? ( px_COM * pz_COM * sinXcosPhi - py_COM * p_COM * sinXsinPhi ) * inv_p_perp + px_COM * cosX : p_COM * sinXcosPhi;
+        double newpy_COM = large_p_perp ? ( py_COM * pz_COM * sinXcosPhi + px_COM * p_COM * sinXsinPhi ) * inv_p_perp + py_COM * cosX : p_COM * sinXsinPhi;
+        double newpz_COM = large_p_perp ? -p_perp * sinXcosPhi  +  pz_COM * cosX : p_COM * cosX;
+        
+        // Go back to the lab frame and store the results
+        double vcp = COM_vx * newpx_COM + COM_vy * newpy_COM + COM_vz * newpz_COM;
+        bool deflect1 = active && U2[k] < w2[k]/w1[k]; // deflect particle 1 only with some probability
+        bool deflect2 = active && U2[k] < w1[k]/w2[k]; // deflect particle 2 only with some probability
+        double term6 = term1*vcp + gamma1_COM * COM_gamma;
+        px1[k] = deflect1 ? newpx_COM + COM_vx * term6 : px1[k];
+        py1[k] = deflect1 ? newpy_COM + COM_vy * term6 : py1[k];
+        pz1[k] = deflect1 ? newpz_COM + COM_vz * term6 : pz1[k];
+        term6 = -m12 * term1*vcp + gamma2_COM * COM_gamma;
+        px2[k] = deflect2 ? -m12 * newpx_COM + COM_vx * term6 : px2[k];
+        py2[k] = deflect2 ? -m12 * newpy_COM + COM_vy * term6 : py2[k];
+        pz2[k] = deflect2 ? -m12 * newpz_COM + COM_vz * term6 : pz2[k];
+        
+        s_out[k] = active ? s : 0.;
+        logL_out[k] = active ? logL : coulomb_log;
+    }
+}
+
+
 void Collisions::debug( Params &params, int itime, unsigned int icoll, VectorPatch &vecPatches )
 {
 
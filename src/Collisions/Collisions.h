@@ -6,6 +6,7 @@
 
 #include "Tools.h"
 #include "H5.h"
+#include "Particles.h"
 #include "CollisionalIonization.h"
 #include "CollisionalNuclearReaction.h"
 #include "CollisionalFusionDD.h"
@@ -28,6 +29,8 @@ public:
         double coulomb_log,
         bool intra_collisions,
         int debug_every,
+        double subcycling_threshold,
+        unsigned int subcycling_max,
         CollisionalIonization *ionization,
         CollisionalNuclearReaction *nuclear_reaction,
         std::string
@@ -46,6 +49,24 @@ public:
     //! Method called in the main smilei loop to apply collisions at each timestep
     virtual void collide( Params &, Patch *, int, std::vector<Diagnostic *> & );
     
+    //! True if the bins may be collided independently, by different threads (see collide_bin)
+    inline bool independent_bins()
+    {
+        return batched_;
+    }
+    
+    //! Resets the debugging quantities, and prepares the sub-cycling, before calls to collide_bin
+    void prepare_bins( Patch *, int itime );
+    
+    //! Collides the pairs of one bin, using a random stream specific to this bin and iteration
+    virtual void collide_bin( Params &, Patch *, int itime, unsigned int ibin );
+    
+    //! Averages the debugging quantities after calls to collide_bin
+    void finish_bins();
+    
+    //! Allocates the temporary arrays of collide_bin for all threads
+    static void allocate_batches();
+    
     //! Outputs the debug info if requested
     static void debug( Params &params, int itime, unsigned int icoll, VectorPatch &vecPatches );
     
@@ -71,6 +92,36 @@ protected:
     //! Number of timesteps between each dump of collisions debugging
     int debug_every_;
     
+    //! Collision parameter that a bin must be expected to reach before being collided (0 = every timestep)
+    double subcycling_threshold_;
+    
+    //! Maximum number of timesteps between two collisions of a bin
+    unsigned int subcycling_max_;
+    
+    //! For each bin, number of timesteps elapsed since its last collision
+    std::vector<unsigned int> bin_elapsed_steps_;
+    
+    //! For each bin, mean collision parameter per timestep measured at its last collision (negative if unknown)
+    std::vector<double> bin_s_rate_;
+    
+    //! Decides whether a sub-cycled bin collides at this timestep, and over how many timesteps
+    inline bool bin_collides_now( unsigned int ibin, double &elapsed_steps )
+    {
+        elapsed_steps = 1.;
+        if( subcycling_threshold_ <= 0. ) {
+            return true;
+        }
+        bin_elapsed_steps_[ibin]++;
+        if( bin_s_rate_[ibin] >= 0.
+            && bin_elapsed_steps_[ibin] < subcycling_max_
+            && bin_s_rate_[ibin] * bin_elapsed_steps_[ibin] < subcycling_threshold_ ) {
+            return false;
+        }
+        elapsed_steps = bin_elapsed_steps_[ibin];
+        bin_elapsed_steps_[ibin] = 0;
+        return true;
+    }
+    
     //! Hdf5 file name
     std::string filename_;
     
@@ -80,6 +131,82 @@ protected:
     const double twoPi = 2. * 3.14159265358979323846;
     double coeff1_, coeff2_;
     
+    //! True when pairs are collided by batches (no ionization nor nuclear reaction)
+    bool batched_;
+    
+    //! Pairs of macro-particles gathered in contiguous arrays, to be collided by collide_batch
+    struct PairBatch {
+        void resize( unsigned int n )
+        {
+            part1.resize( n ); part2.resize( n ); i1.resize( n ); i2.resize( n );
+            px1.resize( n ); py1.resize( n ); pz1.resize( n );
+            px2.resize( n ); py2.resize( n ); pz2.resize( n );
+            m1.resize( n ); m2.resize( n ); q1.resize( n ); q2.resize( n ); w1.resize( n ); w2.resize( n );
+            weight_correction.resize( n ); U1.resize( n ); U2.resize( n ); phi.resize( n );
+            s.resize( n ); logL.resize( n );
+        }
+        std::vector<Particles *> part1, part2;
+        std::vector<unsigned int> i1, i2;
+        std::vector<double> px1, py1, pz1, px2, py2, pz2, m1, m2, q1, q2, w1, w2;
+        std::vector<double> weight_correction, U1, U2, phi;
+        std::vector<double> s, logL;
+        //! Shuffled indices of the particles of each group, in the current bin
+        std::vector<unsigned int> index1, index2;
+        //! Species and index of each particle of each group, in the current bin
+        std::vector<Particles *> group1_particles, group2_particles;
+        std::vector<unsigned int> group1_index, group2_index;
+        std::vector<double> group1_mass, group2_mass;
+    };
+    
+    //! Temporary arrays of collide_bin, one per thread
+    static std::vector<PairBatch> batches_;
+    
+    //! Whether debugging quantities are accumulated by collide_bin at this iteration
+    bool debug_bins_;
+    
+    //! Number of pairs collided since prepare_bins
+    double ncol_;
+    
+    //! Copies one pair of particles in the batch
+    inline void gather_pair( PairBatch &batch, unsigned int k, Particles *p1, unsigned int i1, double m1, Particles *p2, unsigned int i2, double m2, double weight_correction )
+    {
+        batch.part1[k] = p1;
+        batch.part2[k] = p2;
+        batch.i1[k] = i1;
+        batch.i2[k] = i2;
+        batch.px1[k] = p1->momentum( 0, i1 );
+        batch.py1[k] = p1->momentum( 1, i1 );
+        batch.pz1[k] = p1->momentum( 2, i1 );
+        batch.px2[k] = p2->momentum( 0, i2 );
+        batch.py2[k] = p2->momentum( 1, i2 );
+        batch.pz2[k] = p2->momentum( 2, i2 );
+        batch.m1[k] = m1;
+        batch.m2[k] = m2;
+        batch.q1[k] = p1->charge( i1 );
+        batch.q2[k] = p2->charge( i2 );
+        batch.w1[k] = p1->weight( i1 );
+        batch.w2[k] = p2->weight( i2 );
+        batch.weight_correction[k] = weight_correction;
+    }
+    
+    //! Collides the first n pairs of the batch (same physics as one_collision, without nuclear reaction)
+    void collide_batch( PairBatch &batch, unsigned int n, double coeff3, double coeff4, double n123, double n223, double debye2 );
+    
+    //! Copies the momenta of the first n pairs of the batch back to the particles
+    inline void scatter_batch( PairBatch &batch, unsigned int n )
+    {
+        for( unsigned int k=0; k<n; k++ ) {
+            Particles *p1 = batch.part1[k], *p2 = batch.part2[k];
+            unsigned int i1 = batch.i1[k], i2 = batch.i2[k];
+            p1->momentum( 0, i1 ) = batch.px1[k];
+            p1->momentum( 1, i1 ) = batch.py1[k];
+            p1->momentum( 2, i1 ) = batch.pz1[k];
+            p2->momentum( 0, i2 ) = batch.px2[k];
+            p2->momentum( 1, i2 ) = batch.py2[k];
+            p2->momentum( 2, i2 ) = batch.pz2[k];
+        }
+    }
+    
     // Collide one particle with another
     // See equations in http://dx.doi.org/10.1063/1.4742167
     inline double one_collision(
@@ -70,6 +70,18 @@ public:
         debug_every = 0; // default
         PyTools::extract( "debug_every", debug_every, "Collisions", n_collisions );
         
+        // Sub-cycling of the bins (if 0 or unset, all bins are collided at each timestep)
+        double subcycling_threshold = 0.; // default
+        PyTools::extract( "subcycling_threshold", subcycling_threshold, "Collisions", n_collisions );
+        if( subcycling_threshold < 0. ) {
+            ERROR( "In collisions #" << n_collisions << ": `subcycling_threshold` must be positive" );
+        }
+        unsigned int subcycling_max = 10; // default
+        PyTools::extract( "subcycling_max", subcycling_max, "Collisions", n_collisions );
+        if( subcycling_max < 1 ) {
+            ERROR( "In collisions #" << n_collisions << ": `subcycling_max` must be at least 1" );
+        }
+        
         // Collisional ionization
         Z = 0; // default
         PyObject * ionizing = PyTools::extract_py( "ionizing", "Collisions", n_collisions );
@@ -226,6 +238,10 @@ public:
         }
         Py_DECREF( py_nuclear_reaction );
         
+        if( subcycling_threshold > 0. && ( ionization || py_nuclear_reaction != Py_None ) ) {
+            ERROR( "In collisions #" << n_collisions << ": cannot sub-cycle with ionization or nuclear reactions" );
+        }
+        
         // Print collisions parameters
         mystream.str( "" ); // clear
         mystream << "(" << sgroup[0][0];
@@ -245,6 +261,9 @@ public:
         if( debug_every>0 ) {
             MESSAGE( 2, "Debug every " << debug_every << " timesteps" );
         }
+        if( subcycling_threshold>0. ) {
+            MESSAGE( 2, "Sub-cycling of bins below s = " << subcycling_threshold << ", at most " << subcycling_max << " timesteps" );
+        }
         mystream.str( "" ); // clear
         if( ionization_electrons>0 ) {
             MESSAGE( 2, "Collisional ionization with atomic number "<<Z<<" towards species `"<<vecSpecies[ionization_electrons]->name_ << "`" );
@@ -297,6 +316,8 @@ public:
                        sgroup[1],
                        clog, intra,
                        debug_every,
+                       subcycling_threshold,
+                       subcycling_max,
                        Ionization,
                        NuclearReaction,
                        filename
@@ -309,6 +330,8 @@ public:
                        sgroup[1],
                        clog, intra,
                        debug_every,
+                       subcycling_threshold,
+                       subcycling_max,
                        Ionization,
                        NuclearReaction,
                        filename
@@ -343,6 +366,11 @@ public:
         // pass the variable "debye_length_required" into the Collision class
         Collisions::debye_length_required = debye_length_required;
         
+        // temporary arrays for colliding bins in each thread
+        if( numcollisions > 0 ) {
+            Collisions::allocate_batches();
+        }
+        
         return vecCollisions;
     }
     
@@ -12,6 +12,10 @@
 #include "Patch.h"
 #include "VectorPatch.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 
 
@@ -21,6 +25,16 @@ using namespace std;
 // but is potentially faster
 void CollisionsSingle::collide( Params &params, Patch *patch, int itime, vector<Diagnostic *> &localDiags )
 {
+    // Collide the bins independently when possible
+    if( batched_ ) {
+        prepare_bins( patch, itime );
+        unsigned int nbin = patch->vecSpecies[0]->particles->first_index.size();
+        for( unsigned int ibin = 0 ; ibin < nbin ; ibin++ ) {
+            collide_bin( params, patch, itime, ibin );
+        }
+        finish_bins();
+        return;
+    }
 
     vector<unsigned int> index1;
     unsigned int npairs; // number of pairs of macro-particles
@@ -169,3 +183,148 @@ void CollisionsSingle::collide( Params &params, Patch *patch, int itime, vector<
         //temperature /= ncol;
     }
 }
+
+
+// Collides the pairs of one bin by batches
+// The random numbers come from a stream which only depends on the patch, bin and iteration,
+// so that the result does not depend on which thread collides which bin
+void CollisionsSingle::collide_bin( Params &params, Patch *patch, int itime, unsigned int ibin )
+{
+    int ithread = 0;
+#ifdef _OPENMP
+    ithread = omp_get_thread_num();
+#endif
+    PairBatch &batch = batches_[ithread];
+    
+    // Sub-cycling: skip the bin while its expected collision parameter remains small
+    double elapsed_steps;
+    if( ! bin_collides_now( ibin, elapsed_steps ) ) {
+        return;
+    }
+    
+    Random rand( params.random_seed, patch->Hindex(), ( ( uint64_t ) n_collisions_ << 32 ) + ibin, itime );
+    
+    Species *s1 = patch->vecSpecies[species_group1_[0]];
+    Species *s2 = patch->vecSpecies[species_group2_[0]];
+    
+    // get number of particles for all necessary species
+    unsigned int np1 = s1->particles->last_index[ibin] - s1->particles->first_index[ibin];
+    unsigned int np2 = s2->particles->last_index[ibin] - s2->particles->first_index[ibin];
+    // skip if no particles
+    if( np1==0 || np2==0 ) {
+        return;
+    }
+    // Ensure species 1 has more macro-particles
+    if( np2 > np1 ) {
+        swap( s1, s2 );
+        swap( np1, np2 );
+    }
+    unsigned int first_index1 = s1->particles->first_index[ibin];
+    unsigned int first_index2 = s2->particles->first_index[ibin];
+    Particles *p1 = s1->particles;
+    Particles *p2 = s2->particles;
+    
+    double debye2 = 0.;
+    if( Collisions::debye_length_required ) {
+        debye2 = patch->debye_length_squared[ibin];
+    }
+    
+    unsigned int npairs, N2max;
+    if( intra_collisions_ ) { // In the case of collisions within one species
+        if( np1 < 2 ) {
+            return;
+        }
+        npairs = ( np1 + 1 ) / 2; // half as many pairs as macro-particles
+        N2max = np1 - npairs; // number of not-repeated particles (in second half only)
+        first_index2 += npairs;
+    } else { // In the case of collisions between two species
+        npairs = np1; // as many pairs as macro-particles in species 1 (most numerous)
+        N2max = np2; // number of not-repeated particles (in species 2 only)
+    }
+    // Shuffle one particle in each pair
+    // (particles are not exchanged, as it would resize the particle arrays, shared by all threads)
+    vector<unsigned int> &index1 = batch.index1;
+    index1.resize( npairs );
+    for( unsigned int i=0; i<npairs; i++ ) {
+        index1[i] = first_index1 + i;
+    }
+    for( unsigned int i=npairs; i>1; i-- ) {
+        unsigned int p = rand.integer() % i;
+        swap( index1[i-1], index1[p] );
+    }
+    
+    // Calculate the densities
+    double n1  = 0.; // density of species 1
+    for( unsigned int i=first_index1; i<first_index1+npairs; i++ ) {
+        n1 += p1->weight( i );
+    }
+    double n2  = 0.; // density of species 2
+    for( unsigned int i=first_index2; i<first_index2+N2max; i++ ) {
+        n2 += p2->weight( i );
+    }
+    if( intra_collisions_ ) {
+        n1 += n2;
+        n2 = n1;
+    }
+    
+    // Pre-calculate some numbers before the big loop
+    double inv_cell_volume = 1./patch->getPrimalCellVolume( p1, first_index1, params );
+    unsigned int ncorr = intra_collisions_ ? 2*npairs-1 : npairs;
+    double dt_corr = params.timestep * elapsed_steps * ((double)ncorr) * inv_cell_volume;
+    double coeff3 = coeff2_ * dt_corr;
+    double coeff4 = pow( 3.*coeff2_, -1./3. ) * dt_corr;
+    double weight_correction_1 = 1. / (double)( (npairs-1) / N2max );
+    double weight_correction_2 = 1. / (double)( (npairs-1) / N2max + 1. );
+    n1  *= inv_cell_volume;
+    n2  *= inv_cell_volume;
+    double n123 = pow( n1, 2./3. );
+    double n223 = pow( n2, 2./3. );
+    
+    // Particles of species 2 are repeated every N2max pairs: pairs are collided
+    // by batches of N2max so that a batch never contains the same particle twice
+    double smean = 0., logLmean = 0.;
+    for( unsigned int ipair0 = 0; ipair0<npairs; ipair0 += N2max ) {
+        unsigned int n = min( N2max, npairs - ipair0 );
+        batch.resize( n );
+        for( unsigned int k = 0; k<n; k++ ) {
+            unsigned int i1 = index1[ipair0 + k];
+            unsigned int i2 = first_index2 + k;
+            
+            double weight_correction = std::max( p1->weight( i1 ), p2->weight( i2 ) );
+            if( k <= ( npairs-1 ) % N2max ) {
+                weight_correction *= weight_correction_2 ;
+            } else {
+                weight_correction *= weight_correction_1;
+            }
+            gather_pair( batch, k, p1, i1, s1->mass_, p2, i2, s2->mass_, weight_correction );
+            
+            batch.U1 [k] = rand.uniform();
+            batch.U2 [k] = rand.uniform();
+            batch.phi[k] = rand.uniform_2pi();
+        }
+        
+        collide_batch( batch, n, coeff3, coeff4, n123, n223, debye2 );
+        scatter_batch( batch, n );
+        
+        if( debug_bins_ || subcycling_threshold_ > 0. ) {
+            for( unsigned int k = 0; k<n; k++ ) {
+                smean    += batch.s[k];
+                logLmean += batch.logL[k];
+            }
+        }
+    }
+    
+    // Collision parameter per timestep, to decide when this bin will be collided again
+    if( subcycling_threshold_ > 0. ) {
+        bin_s_rate_[ibin] = smean / ( npairs * elapsed_steps );
+    }
+    
+    if( debug_bins_ ) {
+        #pragma omp atomic
+        ncol_ += npairs;
+        #pragma omp atomic
+        smean_ += smean;
+        #pragma omp atomic
+        logLmean_ += logLmean;
+    }
+}
@@ -26,6 +26,8 @@ public:
         double coulomb_log,
         bool intra_collisions,
         int debug_every,
+        double subcycling_threshold,
+        unsigned int subcycling_max,
         CollisionalIonization *ionization,
         CollisionalNuclearReaction *nuclear_reaction,
         std::string fname
@@ -37,6 +39,8 @@ public:
         coulomb_log,
         intra_collisions,
         debug_every,
+        subcycling_threshold,
+        subcycling_max,
         ionization,
         nuclear_reaction,
         fname
@@ -50,6 +54,9 @@ public:
     //! Method called in the main smilei loop to apply collisions at each timestep
     void collide( Params &, Patch *, int, std::vector<Diagnostic *> & ) override;
     
+    //! Collides the pairs of one bin, using a random stream specific to this bin and iteration
+    void collide_bin( Params &, Patch *, int itime, unsigned int ibin ) override;
+    
 };
 
 
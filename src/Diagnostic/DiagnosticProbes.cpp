@@ -325,6 +325,16 @@ DiagnosticProbes::DiagnosticProbes( Params &params, SmileiMPI *smpi, VectorPatch
     for( unsigned int k=0; k<nDim_particle; k++ ) {
         patch_size[k] = params.n_space[k]*params.cell_length[k];
     }
+    
+    // In cartesian geometries, the interpolation weights of each point only change
+    // when points are re-created, so they are computed once and cached per patch
+    use_stencils = geometry != "AMcylindrical"
+                   && ( params.interpolation_order == 2 || params.interpolation_order == 4 );
+    stencil_size = params.interpolation_order + 1;
+    cell_length_inv.resize( nDim_field );
+    for( unsigned int k=0; k<nDim_field; k++ ) {
+        cell_length_inv[k] = 1./params.cell_length[k];
+    }
 
     // Create filename
     ostringstream mystream( "" );
@@ -578,6 +588,10 @@ void DiagnosticProbes::createPoints( SmileiMPI *smpi, VectorPatch &vecPatches, b
         // Resize the array with only particles in this patch
         particles->resize( ipart_local, nDim_particle );
         particles->shrinkToFit();
+        
+        if( use_stencils ) {
+            computeStencils( vecPatches( ipatch ), vecPatches( ipatch )->probes[probe_n] );
+        }
 
         // Add the local offset
         offset_in_MPI[ipatch] = nPart_MPI;
@@ -605,6 +619,95 @@ void DiagnosticProbes::createPoints( SmileiMPI *smpi, VectorPatch &vecPatches, b
 
 
 
+
+// Interpolation weights of the stencil nodes, for a point at a normalized distance delta from the central node
+static inline void stencilCoefficients( unsigned int order, double delta, double *coeff )
+{
+    double delta2 = delta*delta;
+    if( order == 2 ) {
+        coeff[0] = 0.5 * ( delta2-delta+0.25 );
+        coeff[1] = 0.75 - delta2;
+        coeff[2] = 0.5 * ( delta2+delta+0.25 );
+    } else {
+        double delta3 = delta2*delta;
+        double delta4 = delta3*delta;
+        coeff[0] = 1./384.   - 1./48.  * delta + 1./16. * delta2 - 1./12. * delta3 + 1./24. * delta4;
+        coeff[1] = 19./96.   - 11./24. * delta + 1./4.  * delta2 + 1./6.  * delta3 - 1./6.  * delta4;
+        coeff[2] = 115./192. - 5./8.   * delta2 + 1./4. * delta4;
+        coeff[3] = 19./96.   + 11./24. * delta + 1./4.  * delta2 - 1./6.  * delta3 - 1./6.  * delta4;
+        coeff[4] = 1./384.   + 1./48.  * delta + 1./16. * delta2 + 1./12. * delta3 + 1./24. * delta4;
+    }
+}
+
+// Same stencils as the cartesian interpolators, stored for each point as
+// [ipart][idim][primal or dual] so that each field only needs the weighted sum of its nodes
+void DiagnosticProbes::computeStencils( Patch *patch, ProbeParticles *probe )
+{
+    unsigned int npart = probe->particles.size();
+    unsigned int order = stencil_size - 1;
+    int half = order / 2;
+    
+    probe->stencil_index.resize( npart*nDim_field*2 );
+    probe->stencil_coeff.resize( npart*nDim_field*2*stencil_size );
+    
+    for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+        for( unsigned int idim=0; idim<nDim_field; idim++ ) {
+            double xpn = probe->particles.position( idim, ipart ) * cell_length_inv[idim];
+            int domain_begin = patch->getCellStartingGlobalIndex( idim );
+            unsigned int istencil = ( ipart*nDim_field + idim )*2;
+            // Primal
+            int ip = round( xpn );
+            probe->stencil_index[istencil] = ip - half - domain_begin;
+            stencilCoefficients( order, xpn - ( double )ip, &probe->stencil_coeff[istencil*stencil_size] );
+            // Dual
+            int id = round( xpn+0.5 );
+            probe->stencil_index[istencil+1] = id - half - domain_begin;
+            stencilCoefficients( order, xpn - ( double )id + 0.5, &probe->stencil_coeff[( istencil+1 )*stencil_size] );
+        }
+    }
+}
+
+void DiagnosticProbes::interpolateWithStencils( Field *field, ProbeParticles *probe, double *FieldLoc )
+{
+    unsigned int npart = probe->particles.size();
+    
+    // Unused dimensions get a single node of weight 1
+    double one = 1.;
+    unsigned int n[3] = { 1, 1, 1 };
+    int stride[3] = { 0, 0, 0 };
+    unsigned int dual[3] = { 0, 0, 0 };
+    int s = 1;
+    for( int idim=nDim_field-1; idim>=0; idim-- ) {
+        n[idim] = stencil_size;
+        stride[idim] = s;
+        s *= field->dims_[idim];
+        dual[idim] = field->isDual( idim );
+    }
+    double *data = field->data_;
+    
+    for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+        int *index = &probe->stencil_index[ipart*nDim_field*2];
+        double *coeff = &probe->stencil_coeff[ipart*nDim_field*2*stencil_size];
+        double *cx = &coeff[dual[0]*stencil_size];
+        double *cy = nDim_field > 1 ? &coeff[( 2+dual[1] )*stencil_size] : &one;
+        double *cz = nDim_field > 2 ? &coeff[( 4+dual[2] )*stencil_size] : &one;
+        double *f = data + index[dual[0]]*stride[0]
+                    + ( nDim_field > 1 ? index[2+dual[1]]*stride[1] : 0 )
+                    + ( nDim_field > 2 ? index[4+dual[2]] : 0 );
+        double res = 0.;
+        for( unsigned int i=0; i<n[0]; i++ ) {
+            for( unsigned int j=0; j<n[1]; j++ ) {
+                double cxy = cx[i]*cy[j];
+                double *fij = f + i*stride[0] + j*stride[1];
+                for( unsigned int k=0; k<n[2]; k++ ) {
+                    res += cxy * cz[k] * fij[k];
+                }
+            }
+        }
+        FieldLoc[ipart] = res;
+    }
+}
+
 void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int timestep, SimWindow *simWindow, Timers &timers )
 {
     ostringstream name_t;
@@ -721,28 +824,44 @@ void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int timest
 #endif
         
         // Interpolate all usual fields
-        smpi->dynamics_resize( ithread, nDim_particle, npart, false );
-        for( unsigned int ipart=0; ipart<npart; ipart++ ) {
-            int iparticle( ipart ); // Compatibility
-            int false_idx( 0 );   // Use in classical interp for now, not for probes
-            patch->probesInterp->fieldsAndCurrents(
-                patch->EMfields,
-                patch->probes[probe_n]->particles, smpi,
-                &iparticle, &false_idx, ithread,
-                &Jloc_fields, &Rloc_fields
-            );
-            //! here we fill the probe data!!!
-            ( *probesArray )( fieldlocation[0], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+0*npart];
-            ( *probesArray )( fieldlocation[1], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+1*npart];
-            ( *probesArray )( fieldlocation[2], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+2*npart];
-            ( *probesArray )( fieldlocation[3], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+0*npart];
-            ( *probesArray )( fieldlocation[4], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+1*npart];
-            ( *probesArray )( fieldlocation[5], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+2*npart];
-            ( *probesArray )( fieldlocation[6], iPart_MPI )=Jloc_fields.x;
-            ( *probesArray )( fieldlocation[7], iPart_MPI )=Jloc_fields.y;
-            ( *probesArray )( fieldlocation[8], iPart_MPI )=Jloc_fields.z;
-            ( *probesArray )( fieldlocation[9], iPart_MPI )=Rloc_fields;
-            iPart_MPI++;
+        if( use_stencils ) {
+            ElectroMagn *EMfields = patch->EMfields;
+            Field *fields[10] = {
+                EMfields->Ex_, EMfields->Ey_, EMfields->Ez_,
+                EMfields->Bx_m, EMfields->By_m, EMfields->Bz_m,
+                EMfields->Jx_, EMfields->Jy_, EMfields->Jz_, EMfields->rho_
+            };
+            for( unsigned int ifield=0; ifield<10; ifield++ ) {
+                // Skip fields that were not requested
+                if( fieldlocation[ifield] < ( unsigned int )nFields ) {
+                    double *FieldLoc = &( ( *probesArray )( fieldlocation[ifield], offset_in_MPI[ipatch] ) );
+                    interpolateWithStencils( fields[ifield], patch->probes[probe_n], FieldLoc );
+                }
+            }
+        } else {
+            smpi->dynamics_resize( ithread, nDim_particle, npart, false );
+            for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+                int iparticle( ipart ); // Compatibility
+                int false_idx( 0 );   // Use in classical interp for now, not for probes
+                patch->probesInterp->fieldsAndCurrents(
+                    patch->EMfields,
+                    patch->probes[probe_n]->particles, smpi,
+                    &iparticle, &false_idx, ithread,
+                    &Jloc_fields, &Rloc_fields
+                );
+                //! here we fill the probe data!!!
+                ( *probesArray )( fieldlocation[0], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+0*npart];
+                ( *probesArray )( fieldlocation[1], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+1*npart];
+                ( *probesArray )( fieldlocation[2], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+2*npart];
+                ( *probesArray )( fieldlocation[3], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+0*npart];
+                ( *probesArray )( fieldlocation[4], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+1*npart];
+                ( *probesArray )( fieldlocation[5], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+2*npart];
+                ( *probesArray )( fieldlocation[6], iPart_MPI )=Jloc_fields.x;
+                ( *probesArray )( fieldlocation[7], iPart_MPI )=Jloc_fields.y;
+                ( *probesArray )( fieldlocation[8], iPart_MPI )=Jloc_fields.z;
+                ( *probesArray )( fieldlocation[9], iPart_MPI )=Rloc_fields;
+                iPart_MPI++;
+            }
         }
 
         // Interpolate the species-related fields
@@ -773,12 +892,16 @@ void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int timest
                     unsigned int iloc = species_field_location[ispec][j];
                     int istart( 0 ), iend( npart );
                     double *FieldLoc = &( ( *probesArray )( iloc, offset_in_MPI[ipatch] ) );
-                    patch->probesInterp->oneField(
-                        &patch->EMfields->allFields[start+ifield],
-                        patch->probes[probe_n]->particles,
-                        &istart, &iend,
-                        FieldLoc
-                    );
+                    if( use_stencils ) {
+                        interpolateWithStencils( patch->EMfields->allFields[start+ifield], patch->probes[probe_n], FieldLoc );
+                    } else {
+                        patch->probesInterp->oneField(
+                            &patch->EMfields->allFields[start+ifield],
+                            patch->probes[probe_n]->particles,
+                            &istart, &iend,
+                            FieldLoc
+                        );
+                    }
                 }
             }
         }
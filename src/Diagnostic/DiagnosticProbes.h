@@ -5,6 +5,7 @@
 
 #include "Field2D.h"
 
+class ProbeParticles;
 
 class DiagnosticProbes : public Diagnostic
 {
@@ -32,6 +33,12 @@ public :
     //! Creates the probe's particles (or "points")
     void createPoints( SmileiMPI *smpi, VectorPatch &vecPatches, bool createFile, double x_moved );
     
+    //! Computes the interpolation stencils of the points of one patch
+    void computeStencils( Patch *patch, ProbeParticles *probe );
+    
+    //! Interpolates one field at the points of one patch using their cached stencils
+    void interpolateWithStencils( Field *field, ProbeParticles *probe, double *FieldLoc );
+    
     //! Get memory footprint of current diagnostic
     int getMemFootPrint() override
     {
@@ -40,6 +47,8 @@ public :
                    ( nDim_particle+3+1 )*sizeof( double ) + sizeof( short )
                    // eval probesArray (even if temporary)
                    + 10*sizeof( double )
+                   // cached interpolation stencils
+                   + ( use_stencils ? 2*nDim_field*( sizeof( int ) + stencil_size*sizeof( double ) ) : 0 )
                );
     }
     
@@ -123,6 +132,15 @@ private :
     
     //! patch size
     std::vector<double> patch_size;
+    
+    //! Inverse of the cell lengths
+    std::vector<double> cell_length_inv;
+    
+    //! Whether the points are interpolated with cached stencils instead of the interpolator
+    bool use_stencils;
+    
+    //! Number of grid nodes, in each dimension, used to interpolate one point
+    unsigned int stencil_size;
 };
 
 
@@ -139,6 +157,11 @@ public :
     
     Particles particles;
     int offset_in_file;
+    
+    //! For each point, dimension and staggering (primal, dual), index of the first node of the stencil
+    std::vector<int> stencil_index;
+    //! For each point, dimension and staggering (primal, dual), interpolation weights of the stencil nodes
+    std::vector<double> stencil_coeff;
 };
 
 
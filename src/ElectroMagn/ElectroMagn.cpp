@@ -89,6 +89,7 @@ ElectroMagn::ElectroMagn( Params &params, DomainDecomposition *domain_decomposit
     emBoundCond = ElectroMagnBC_Factory::create( params, patch );
     MaxwellAmpereSolver_  = SolverFactory::createMA( params );
     MaxwellFaradaySolver_ = SolverFactory::createMF( params );
+    MaxwellSolver_        = SolverFactory::createMAMF( params );
     
     envelope = NULL;
     
@@ -147,6 +148,7 @@ ElectroMagn::ElectroMagn( ElectroMagn *emFields, Params &params, Patch *patch )
     
     MaxwellAmpereSolver_  = SolverFactory::createMA( params );
     MaxwellFaradaySolver_ = SolverFactory::createMF( params );
+    MaxwellSolver_        = SolverFactory::createMAMF( params );
     
     envelope = NULL;
 }
@@ -361,6 +363,9 @@ ElectroMagn::~ElectroMagn()
         
     delete MaxwellAmpereSolver_;
     delete MaxwellFaradaySolver_;
+    if( MaxwellSolver_ ) {
+        delete MaxwellSolver_;
+    }
     
     if( envelope != NULL ) {
         delete envelope;
@@ -455,6 +460,21 @@ void ElectroMagn::boundaryConditions( int itime, double time_dual, Patch *patch,
     }
 }
 
+void ElectroMagn::correctPML( bool electric, double time_dual, Patch *patch, SimWindow *simWindow )
+{
+    // As the other boundary conditions, the layers along x are not applied while the window moves
+    unsigned int first = ( simWindow && simWindow->isMoving( time_dual ) ) ? 2 : 0;
+    for( unsigned int i=first; i<emBoundCond.size(); i++ ) {
+        if( emBoundCond[i] ) {
+            if( electric ) {
+                emBoundCond[i]->correctE( this, patch );
+            } else {
+                emBoundCond[i]->correctB( this, patch );
+            }
+        }
+    }
+}
+
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Reinitialize the total charge densities and currents
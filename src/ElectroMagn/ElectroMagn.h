@@ -324,6 +324,8 @@ public:
     Solver *MaxwellAmpereSolver_;
     //! Maxwell Faraday Solver
     Solver *MaxwellFaradaySolver_;
+    //! Solver saving B and solving both Maxwell-Ampere and Maxwell-Faraday in a single sweep (NULL if not available)
+    Solver *MaxwellSolver_;
     virtual void saveMagneticFields( bool ) = 0;
     virtual void centerMagneticFields() = 0;
     virtual void binomialCurrentFilter(unsigned int ipass, std::vector<unsigned int> passes ) = 0;
@@ -331,6 +333,9 @@ public:
     
     void boundaryConditions( int itime, double time_dual, Patch *patch, Params &params, SimWindow *simWindow );
     
+    //! Corrections of the absorbing layers (PML) just after Maxwell-Ampere (electric) or Maxwell-Faraday
+    void correctPML( bool electric, double time_dual, Patch *patch, SimWindow *simWindow );
+    
     void laserDisabled();
     
     void incrementAvgField( Field *field, Field *field_avg );
@@ -1201,7 +1201,10 @@ void ElectroMagn2D::centerMagneticFields()
     Field2D *By2D_m = static_cast<Field2D *>( By_m );
     Field2D *Bz2D_m = static_cast<Field2D *>( Bz_m );
     
+    const bool threaded = Tools::shareAmongThreads( nx_d*ny_d );
+    
     // Magnetic field Bx^(p,d)
+    #pragma omp parallel for schedule(static) if( threaded )
     for( unsigned int i=0 ; i<nx_p ; i++ ) {
         #pragma omp simd
         for( unsigned int j=0 ; j<ny_d ; j++ ) {
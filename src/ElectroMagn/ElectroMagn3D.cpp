@@ -1123,9 +1123,13 @@ void ElectroMagn3D::centerMagneticFields()
     Field3D *By3D_m = static_cast<Field3D *>( By_m );
     Field3D *Bz3D_m = static_cast<Field3D *>( Bz_m );
     
+    const bool threaded = Tools::shareAmongThreads( nx_d*ny_d*nz_d );
+    
     // Magnetic field Bx^(p,d,d)
+    #pragma omp parallel for collapse(2) schedule(static) if( threaded )
     for( unsigned int i=0 ; i<nx_p ; i++ ) {
         for( unsigned int j=0 ; j<ny_d ; j++ ) {
+            #pragma omp simd
             for( unsigned int k=0 ; k<nz_d ; k++ ) {
                 ( *Bx3D_m )( i, j, k ) = ( ( *Bx3D )( i, j, k ) + ( *Bx3D_m )( i, j, k ) )*0.5;
             }
@@ -1133,8 +1137,10 @@ void ElectroMagn3D::centerMagneticFields()
     }
     
     // Magnetic field By^(d,p,d)
+    #pragma omp parallel for collapse(2) schedule(static) if( threaded )
     for( unsigned int i=0 ; i<nx_d ; i++ ) {
         for( unsigned int j=0 ; j<ny_p ; j++ ) {
+            #pragma omp simd
             for( unsigned int k=0 ; k<nz_d ; k++ ) {
                 ( *By3D_m )( i, j, k ) = ( ( *By3D )( i, j, k ) + ( *By3D_m )( i, j, k ) )*0.5;
             }
@@ -1142,8 +1148,10 @@ void ElectroMagn3D::centerMagneticFields()
     }
     
     // Magnetic field Bz^(d,d,p)
+    #pragma omp parallel for collapse(2) schedule(static) if( threaded )
     for( unsigned int i=0 ; i<nx_d ; i++ ) {
         for( unsigned int j=0 ; j<ny_d ; j++ ) {
+            #pragma omp simd
             for( unsigned int k=0 ; k<nz_p ; k++ ) {
                 ( *Bz3D_m )( i, j, k ) = ( ( *Bz3D )( i, j, k ) + ( *Bz3D_m )( i, j, k ) )*0.5;
             }
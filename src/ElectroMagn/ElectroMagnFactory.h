@@ -51,6 +51,10 @@ public:
         }
         for( int ilaser = 0; ilaser < nlaser; ilaser++ ) {
             Laser *laser = new Laser( params, ilaser, patch );
+            if( ( laser->box_side == "xmin" && params.EM_BCs[0][0] == "PML" )
+                || ( laser->box_side == "xmax" && params.EM_BCs[0][1] == "PML" ) ) {
+                ERROR( "Laser #" << ilaser << ": cannot inject a laser through a PML (" << laser->box_side << ")" );
+            }
             if( laser->box_side == "xmin" && EMfields->emBoundCond[0] ) {
                 if( patch->isXmin() ) {
                     laser->createFields( params, patch );
@@ -156,8 +156,8 @@ Laser::Laser( Params &params, int ilaser, Patch *patch )
         // time envelope
         name.str( "" );
         name << "Laser[" << ilaser <<"].time_envelope";
-        Profile *ptime = new Profile( time_profile, 1, name.str() );
-        Profile *ptime2 = new Profile( time_profile, 1, name.str() );
+        Profile *ptime = new Profile( time_profile, 1, name.str(), true );
+        Profile *ptime2 = new Profile( time_profile, 1, name.str(), true );
         info << endl << "\t\t\ttime envelope      : " << ptime->getInfo();
 
         // space envelope (By)
@@ -260,7 +260,10 @@ LaserProfileSeparable::LaserProfileSeparable(
     chirpProfile_( chirpProfile ),
     spaceProfile_( spaceProfile ),
     phaseProfile_( phaseProfile ),
-    delay_phase_( delay_phase )
+    delay_phase_( delay_phase ),
+    amplitude_( NULL ),
+    amplitude_time_( 0. ),
+    amplitude_computed_( false )
 {
     space_envelope = NULL;
     phase = NULL;
@@ -273,7 +276,10 @@ LaserProfileSeparable::LaserProfileSeparable( LaserProfileSeparable *lp ) :
     chirpProfile_( new Profile( lp->chirpProfile_ ) ),
     spaceProfile_( new Profile( lp->spaceProfile_ ) ),
     phaseProfile_( new Profile( lp->phaseProfile_ ) ),
-    delay_phase_( lp->delay_phase_ )
+    delay_phase_( lp->delay_phase_ ),
+    amplitude_( NULL ),
+    amplitude_time_( 0. ),
+    amplitude_computed_( false )
 {
     space_envelope = NULL;
     phase = NULL;
@@ -300,6 +306,9 @@ LaserProfileSeparable::~LaserProfileSeparable()
     if( phase ) {
         delete phase;
     }
+    if( amplitude_ ) {
+        delete amplitude_;
+    }
 }
 
 
@@ -345,6 +354,7 @@ void LaserProfileSeparable::createFields( Params &params, Patch *patch )
     //Create laser fields
     space_envelope = new Field2D( dim );
     phase          = new Field2D( dim );
+    amplitude_     = new Field2D( dim );
 }
 
 void LaserProfileSeparable::initFields( Params &params, Patch *patch )
@@ -422,19 +432,45 @@ void LaserProfileSeparable::initFields( Params &params, Patch *patch )
             pos[0] += dy;
         }
     }
+    amplitude_computed_ = false;
 }
 
-// Amplitude of a separable laser profile
-double LaserProfileSeparable::getAmplitude( std::vector<double> pos, double t, int j, int k )
+// Amplitudes of a separable laser profile on all the points, once per timestep: the chirp is evaluated
+// once, and the time envelope only where the space envelope is not zero (in a single call if numpy)
+void LaserProfileSeparable::computeAmplitudes( double t )
 {
-    double amp;
+    unsigned int size = amplitude_->globalDims_;
+    const double *env = space_envelope->data();
+    const double *phi = phase->data();
+    double *amp = amplitude_->data();
+
+    active_.resize( size );
+    times_.resize( size );
+    time_envelope_.resize( size );
+    unsigned int n = 0;
+    for( unsigned int i=0; i<size; i++ ) {
+        amp[i] = 0.;
+        if( env[i] != 0. ) {
+            active_[n++] = i;
+        }
+    }
+
+    double omega;
     #pragma omp critical
     {
-        double omega = omega_ * chirpProfile_->valueAt( t );
-        double phi = ( *phase )( j, k );
-        amp = timeProfile_->valueAt( t-( phi+delay_phase_ )/omega ) * ( *space_envelope )( j, k ) * sin( omega*t - phi );
+        omega = omega_ * chirpProfile_->valueAt( t );
+        for( unsigned int i=0; i<n; i++ ) {
+            times_[i] = t-( phi[active_[i]]+delay_phase_ )/omega;
+        }
+        timeProfile_->valuesAtTimes( times_, n, time_envelope_ );
     }
-    return amp;
+
+    for( unsigned int i=0; i<n; i++ ) {
+        unsigned int p = active_[i];
+        amp[p] = time_envelope_[i] * env[p] * sin( omega*t - phi[p] );
+    }
+    amplitude_time_ = t;
+    amplitude_computed_ = true;
 }
 
 //Destructor
@@ -559,7 +595,7 @@ void LaserProfileFile::initFields( Params &params, Patch *patch )
 }
 
 // Amplitude of a laser profile from a file (see LaserOffset)
-double LaserProfileFile::getAmplitude( std::vector<double> pos, double t, int j, int k )
+double LaserProfileFile::getAmplitude( const std::vector<double> &pos, double t, int j, int k )
 {
     double amp = 0;
     unsigned int n = omega.size();
@@ -24,11 +24,11 @@ class LaserProfile
 public:
     LaserProfile() {};
     virtual ~LaserProfile() {};
-    virtual double getAmplitude( std::vector<double> pos, double t, int j, int k )
+    virtual double getAmplitude( const std::vector<double> &pos, double t, int j, int k )
     {
         return 0.;
     };
-    virtual std::complex<double> getAmplitudecomplex( std::vector<double> pos, double t, int j, int k )
+    virtual std::complex<double> getAmplitudecomplex( const std::vector<double> &pos, double t, int j, int k )
     {
         return 0.;
     };
@@ -59,17 +59,17 @@ public:
     void clean();
     
     //! Gets the amplitude from both time and space profiles (By)
-    inline double getAmplitude0( std::vector<double> pos, double t, int j, int k )
+    inline double getAmplitude0( const std::vector<double> &pos, double t, int j, int k )
     {
         return profiles[0]->getAmplitude( pos, t, j, k );
     }
     //! Gets the amplitude from both time and space profiles (Bz)
-    inline double getAmplitude1( std::vector<double> pos, double t, int j, int k )
+    inline double getAmplitude1( const std::vector<double> &pos, double t, int j, int k )
     {
         return profiles[1]->getAmplitude( pos, t, j, k );
     }
 
-    inline std::complex<double> getAmplitudecomplexN( std::vector<double> pos, double t, int j, int k, int imode )
+    inline std::complex<double> getAmplitudecomplexN( const std::vector<double> &pos, double t, int j, int k, int imode )
     {
         return profiles[imode]->getAmplitudecomplex( pos, t, j, k );
     }
@@ -118,14 +118,33 @@ public:
     ~LaserProfileSeparable();
     void createFields( Params &params, Patch *patch );
     void initFields( Params &params, Patch *patch );
-    double getAmplitude( std::vector<double> pos, double t, int j, int k );
+    //! The amplitudes on all the points are computed at the first call for a new time t
+    inline double getAmplitude( const std::vector<double> &pos, double t, int j, int k )
+    {
+        if( !amplitude_computed_ || t != amplitude_time_ ) {
+            computeAmplitudes( t );
+        }
+        return ( *amplitude_ )( j, k );
+    }
 protected:
     Field *space_envelope, *phase;
 private:
+    //! Computes the amplitudes at time t on all the points of the laser fields
+    void computeAmplitudes( double t );
+
     bool primal_;
     double omega_;
     Profile *timeProfile_, *chirpProfile_, *spaceProfile_, *phaseProfile_;
     double delay_phase_;
+
+    //! Amplitudes at the time amplitude_time_ (if already computed)
+    Field *amplitude_;
+    double amplitude_time_;
+    bool amplitude_computed_;
+    //! Buffers for the points where the space envelope is not zero: indices, times at which
+    //! the time envelope is evaluated, and its values
+    std::vector<unsigned int> active_;
+    std::vector<double> times_, time_envelope_;
 };
 
 // Laser profile for non-separable space and time
@@ -138,7 +157,7 @@ public:
     LaserProfileNonSeparable( LaserProfileNonSeparable *lp )
         : spaceAndTimeProfile_( new Profile( lp->spaceAndTimeProfile_ ) ) {};
     ~LaserProfileNonSeparable();
-    inline double getAmplitude( std::vector<double> pos, double t, int j, int k )
+    inline double getAmplitude( const std::vector<double> &pos, double t, int j, int k )
     {
         double amp;
         #pragma omp critical
@@ -146,7 +165,7 @@ public:
         return amp;
     }
 
-    inline std::complex<double> getAmplitudecomplex( std::vector<double> pos, double t, int j, int k )
+    inline std::complex<double> getAmplitudecomplex( const std::vector<double> &pos, double t, int j, int k )
     {
         std::complex<double> amp;
         #pragma omp critical
@@ -171,7 +190,7 @@ public:
     ~LaserProfileFile();
     void createFields( Params &params, Patch *patch );
     void initFields( Params &params, Patch *patch );
-    double getAmplitude( std::vector<double> pos, double t, int j, int k );
+    double getAmplitude( const std::vector<double> &pos, double t, int j, int k );
 protected:
     Field3D *magnitude, *phase;
     std::vector<double> omega;
@@ -188,7 +207,7 @@ public:
     LaserProfileNULL() {};
     ~LaserProfileNULL() {};
     
-    inline double getAmplitude( std::vector<double> pos, double t, int j, int k )
+    inline double getAmplitude( const std::vector<double> &pos, double t, int j, int k )
     {
         return 0.;
     }
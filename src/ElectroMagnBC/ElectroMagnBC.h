@@ -21,6 +21,10 @@ public:
     
     virtual void apply( ElectroMagn *EMfields, double time_dual, Patch *patch ) = 0;
     
+    //! Corrections of the absorbing layers (PML), just after Maxwell-Ampere and Maxwell-Faraday
+    virtual void correctE( ElectroMagn *, Patch * ) {};
+    virtual void correctB( ElectroMagn *, Patch * ) {};
+    
     void laserDisabled();
     
     virtual void save_fields( Field *, Patch *patch ) {};
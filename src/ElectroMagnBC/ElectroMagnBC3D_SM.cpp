@@ -313,6 +313,9 @@ void ElectroMagnBC3D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
     Field3D *Bz3D = static_cast<Field3D *>( EMfields->Bz_ );
     vector<double> pos( 2 );
     
+    // The faces without lasers are shared among the threads for large regions
+    const bool threaded = Tools::shareAmongThreads( nx_d*ny_d*nz_d );
+    
     if( min_max==0 && patch->isXmin() ) {
     
         // for By^(d,p,d)
@@ -400,6 +403,7 @@ void ElectroMagnBC3D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
     } else if( min_max==2 && patch->isYmin() ) {
     
         // for Bx^(p,d,d)
+        #pragma omp parallel for collapse(2) schedule(static) if( threaded )
         for( unsigned int i=patch->isXmin() ; i<nx_p-patch->isXmax() ; i++ ) {
             for( unsigned int k=patch->isZmin() ; k<nz_d-patch->isZmax() ; k++ ) {
                 ( *Bx3D )( i, 0, k ) = - Alpha_SM_S   * ( *Ez3D )( i, 0, k )
@@ -411,6 +415,7 @@ void ElectroMagnBC3D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
         }//i  ---end compute Bx
         
         // for Bz^(d,d,p)
+        #pragma omp parallel for collapse(2) schedule(static) if( threaded )
         for( unsigned int i=patch->isXmin() ; i<nx_d-patch->isXmax() ; i++ ) {
             for( unsigned int k=patch->isZmin() ; k<nz_p-patch->isZmax() ; k++ ) {
                 ( *Bz3D )( i, 0, k ) = Alpha_SM_S   * ( *Ex3D )( i, 0, k )
@@ -423,6 +428,7 @@ void ElectroMagnBC3D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
     } else if( min_max==3 && patch->isYmax() ) {
     
         // for Bx^(p,d,d)
+        #pragma omp parallel for collapse(2) schedule(static) if( threaded )
         for( unsigned int i=patch->isXmin() ; i<nx_p-patch->isXmax() ; i++ ) {
             for( unsigned int k=patch->isZmin() ; k<nz_d-patch->isZmax() ; k++ ) {
             
@@ -436,6 +442,7 @@ void ElectroMagnBC3D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
         }//j  ---end compute Bz
         
         // for Bz^(d,d,p)
+        #pragma omp parallel for collapse(2) schedule(static) if( threaded )
         for( unsigned int i=patch->isXmin() ; i<nx_d-patch->isXmax() ; i++ ) {
             for( unsigned int k=patch->isZmin() ; k<nz_p-patch->isZmax() ; k++ ) {
             
@@ -450,6 +457,7 @@ void ElectroMagnBC3D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
     } else if( min_max==4 && patch->isZmin() ) {
     
         // for Bx^(p,d,d)
+        #pragma omp parallel for collapse(2) schedule(static) if( threaded )
         for( unsigned int i=patch->isXmin() ; i<nx_p-patch->isXmax() ; i++ ) {
             for( unsigned int j=patch->isYmin() ; j<ny_d-patch->isYmax() ; j++ ) {
             
@@ -462,6 +470,7 @@ void ElectroMagnBC3D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
         }//i  ---end compute Bx
         
         // for By^(d,p,d)
+        #pragma omp parallel for collapse(2) schedule(static) if( threaded )
         for( unsigned int i=patch->isXmin() ; i<nx_d-patch->isXmax() ; i++ ) {
             for( unsigned int j=patch->isYmin() ; j<ny_p-patch->isYmax() ; j++ ) {
             
@@ -477,6 +486,7 @@ void ElectroMagnBC3D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
     } else if( min_max==5 && patch->isZmax() ) {
     
         // for Bx^(p,d,d)
+        #pragma omp parallel for collapse(2) schedule(static) if( threaded )
         for( unsigned int i=patch->isXmin() ; i<nx_p-patch->isXmax() ; i++ ) {
             for( unsigned int j=patch->isYmin() ; j<ny_d-patch->isYmax() ; j++ ) {
             
@@ -491,6 +501,7 @@ void ElectroMagnBC3D_SM::apply( ElectroMagn *EMfields, double time_dual, Patch *
         
         
         // for By^(d,p,d)
+        #pragma omp parallel for collapse(2) schedule(static) if( threaded )
         for( unsigned int i=patch->isXmin() ; i<nx_d-patch->isXmax() ; i++ ) {
             for( unsigned int j=patch->isYmin() ; j<ny_p-patch->isYmax() ; j++ ) {
             
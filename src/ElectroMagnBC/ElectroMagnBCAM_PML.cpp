@@ -0,0 +1,71 @@
+
+#include "ElectroMagnBCAM_PML.h"
+
+#include "Params.h"
+#include "Patch.h"
+#include "ElectroMagnAM.h"
+#include "cField2D.h"
+#include "Tools.h"
+
+using namespace std;
+
+ElectroMagnBCAM_PML::ElectroMagnBCAM_PML( Params &params, Patch *patch, unsigned int _min_max )
+    : ElectroMagnBCAM( params, patch, _min_max )
+{
+    Nmode = params.nmodes;
+    
+    profile_.init( min_max, nl_p, params.oversize[0], params.number_of_pml_cells[0],
+                   dl, dt, params.pml_reflection, params.pml_kappa_max, params.pml_alpha_max );
+    
+    // Pairs (Er, Bt) and (Et, Br)
+    for( unsigned int ipair=0; ipair<2; ipair++ ) {
+        unsigned int nr = ipair==0 ? nr_d : nr_p;
+        psiE_[ipair].resize( Nmode*profile_.layerSize( false )*nr, 0. );
+        psiB_[ipair].resize( Nmode*profile_.layerSize( true )*nr, 0. );
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Correct Er and Et on the primal points of the layer, after Maxwell-Ampere
+//   dEr/dt = - dBt/dl   and   dEt/dt = + dBr/dl
+// As in the solver, the points on axis given by the axis conditions are not modified
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagnBCAM_PML::correctE( ElectroMagn *EMfields, Patch *patch )
+{
+    if( ! patch->locateOnBorders( 0, min_max ) ) {
+        return;
+    }
+    ElectroMagnAM *emAM = static_cast<ElectroMagnAM *>( EMfields );
+    unsigned int j_min = patch->isYmin() ? 3 : 0;
+    
+    unsigned int Er_dims[3] = { nl_p, nr_d, 1 }, Er_first[3] = { 0, j_min, 0 };
+    unsigned int Et_dims[3] = { nl_p, nr_p, 1 }, Et_first[3] = { 0, j_min, 0 };
+    for( unsigned int imode=0 ; imode<Nmode ; imode++ ) {
+        profile_.correct( false, emAM->Er_[imode]->cdata_, emAM->Bt_[imode]->cdata_, &psiE_[0][imode*profile_.layerSize( false )*nr_d],
+                          0, Er_dims, Er_first, Er_dims, -dt_ov_dl );
+        profile_.correct( false, emAM->Et_[imode]->cdata_, emAM->Br_[imode]->cdata_, &psiE_[1][imode*profile_.layerSize( false )*nr_p],
+                          0, Et_dims, Et_first, Et_dims, dt_ov_dl );
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Correct Bt and Br on the dual points of the layer, after Maxwell-Faraday (on the same points)
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagnBCAM_PML::correctB( ElectroMagn *EMfields, Patch *patch )
+{
+    if( ! patch->locateOnBorders( 0, min_max ) ) {
+        return;
+    }
+    ElectroMagnAM *emAM = static_cast<ElectroMagnAM *>( EMfields );
+    bool isYmin = patch->isYmin();
+    
+    unsigned int Bt_dims[3] = { nl_d, nr_d, 1 }, Bt_first[3] = { 0, isYmin ? 3u : 1u, 0 }, Bt_last[3] = { nl_d, nr_d-1, 1 };
+    unsigned int Br_dims[3] = { nl_d, nr_p, 1 }, Br_first[3] = { 0, isYmin ? 3u : 0u, 0 };
+    for( unsigned int imode=0 ; imode<Nmode ; imode++ ) {
+        profile_.correct( true, emAM->Bt_[imode]->cdata_, emAM->Er_[imode]->cdata_, &psiB_[0][imode*profile_.layerSize( true )*nr_d],
+                          0, Bt_dims, Bt_first, Bt_last, -dt_ov_dl );
+        profile_.correct( true, emAM->Br_[imode]->cdata_, emAM->Et_[imode]->cdata_, &psiB_[1][imode*profile_.layerSize( true )*nr_p],
+                          0, Br_dims, Br_first, Br_dims, dt_ov_dl );
+    }
+}
+
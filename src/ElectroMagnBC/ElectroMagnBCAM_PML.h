@@ -0,0 +1,37 @@
+
+#ifndef ELECTROMAGNBCAM_PML_H
+#define ELECTROMAGNBCAM_PML_H
+
+#include <vector>
+#include <complex>
+#include "ElectroMagnBCAM.h"
+#include "PML.h"
+
+class Params;
+class ElectroMagn;
+
+//! Convolutional PML at xmin or xmax in AM geometry, applied to each mode (see ElectroMagnBC_PML)
+class ElectroMagnBCAM_PML : public ElectroMagnBCAM
+{
+public:
+
+    ElectroMagnBCAM_PML( Params &params, Patch *patch, unsigned int _min_max );
+    ~ElectroMagnBCAM_PML() {};
+    
+    void apply( ElectroMagn *, double, Patch * ) override {};
+    
+    void correctE( ElectroMagn *EMfields, Patch *patch ) override;
+    void correctB( ElectroMagn *EMfields, Patch *patch ) override;
+    
+private:
+
+    //! Coefficients of the layer
+    PMLProfile profile_;
+    
+    //! Memory variables of the pairs (Er, Bt) and (Et, Br) for all modes, allocated at the first correction
+    std::vector<std::complex<double> > psiE_[2], psiB_[2];
+    
+};
+
+#endif
+
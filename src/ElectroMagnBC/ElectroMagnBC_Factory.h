@@ -13,6 +13,8 @@
 #include "ElectroMagnBCAM_SM.h"
 #include "ElectroMagnBCAM_zero.h"
 #include "ElectroMagnBCAM_BM.h"
+#include "ElectroMagnBC_PML.h"
+#include "ElectroMagnBCAM_PML.h"
 
 #include "Params.h"
 
@@ -74,6 +76,10 @@ public:
                 else if( params.EM_BCs[0][ii] == "reflective" ) {
                     emBoundCond[ii] = new ElectroMagnBC2D_refl( params, patch, ii );
                 }
+                // convolutional PML (absorbing layer)
+                else if( params.EM_BCs[0][ii] == "PML" ) {
+                    emBoundCond[ii] = new ElectroMagnBC_PML( params, patch, ii );
+                }
                 // else: error
                 else if( params.EM_BCs[0][ii] != "periodic" ) {
                     ERROR( "Unknown EM x-boundary condition `" << params.EM_BCs[0][ii] << "`" );
@@ -88,6 +94,10 @@ public:
                 else if( params.EM_BCs[1][ii] == "reflective" ) {
                     emBoundCond[ii+2] = new ElectroMagnBC2D_refl( params, patch, ii+2 );
                 }
+                // convolutional PML (absorbing layer)
+                else if( params.EM_BCs[1][ii] == "PML" ) {
+                    emBoundCond[ii+2] = new ElectroMagnBC_PML( params, patch, ii+2 );
+                }
                 // else: error
                 else if( params.EM_BCs[1][ii] != "periodic" ) {
                     ERROR( "Unknown EM y-boundary condition `" << params.EM_BCs[1][ii] << "`" );
@@ -115,6 +125,10 @@ public:
                 else if( params.EM_BCs[0][ii] == "buneman" ) {
                     emBoundCond[ii] = new ElectroMagnBC3D_BM( params, patch, ii );
                 }
+                // convolutional PML (absorbing layer)
+                else if( params.EM_BCs[0][ii] == "PML" ) {
+                    emBoundCond[ii] = new ElectroMagnBC_PML( params, patch, ii );
+                }
                 // else: error
                 else if( params.EM_BCs[0][ii] != "periodic" ) {
                     ERROR( "Unknown EM x-boundary condition `" << params.EM_BCs[0][ii] << "`" );
@@ -133,6 +147,10 @@ public:
                 else if( params.EM_BCs[1][ii] == "buneman" ) {
                     emBoundCond[ii+2] = new ElectroMagnBC3D_BM( params, patch, ii+2 );
                 }
+                // convolutional PML (absorbing layer)
+                else if( params.EM_BCs[1][ii] == "PML" ) {
+                    emBoundCond[ii+2] = new ElectroMagnBC_PML( params, patch, ii+2 );
+                }
                 // else: error
                 else if( params.EM_BCs[1][ii] != "periodic" ) {
                     ERROR( "Unknown EM y-boundary condition `" << params.EM_BCs[1][ii] << "`" );
@@ -151,6 +169,10 @@ public:
                 else if( params.EM_BCs[2][ii] == "buneman" ) {
                     emBoundCond[ii+4] = new ElectroMagnBC3D_BM( params, patch, ii+4 );
                 }
+                // convolutional PML (absorbing layer)
+                else if( params.EM_BCs[2][ii] == "PML" ) {
+                    emBoundCond[ii+4] = new ElectroMagnBC_PML( params, patch, ii+4 );
+                }
                 // else: error
                 else if( params.EM_BCs[2][ii] != "periodic" ) {
                     ERROR( "Unknown EM z-boundary condition `" << params.EM_BCs[2][ii] << "`" );
@@ -174,6 +196,9 @@ public:
                 else if( params.EM_BCs[0][ii] == "zero" ) {
                     emBoundCond[ii] = new ElectroMagnBCAM_zero( params, patch, ii );
                 }
+                else if( params.EM_BCs[0][ii] == "PML" ) {
+                    emBoundCond[ii] = new ElectroMagnBCAM_PML( params, patch, ii );
+                }
                 else if( params.EM_BCs[0][ii] != "periodic" ) {
                     ERROR( "Unknown EM x-boundary condition `" << params.EM_BCs[0][ii] << "`" );
                 }
@@ -0,0 +1,111 @@
+
+#include "ElectroMagnBC_PML.h"
+
+#include "Params.h"
+#include "Patch.h"
+#include "ElectroMagn.h"
+#include "Field.h"
+#include "Tools.h"
+
+using namespace std;
+
+ElectroMagnBC_PML::ElectroMagnBC_PML( Params &params, Patch *patch, unsigned int _min_max )
+    : ElectroMagnBC( params, patch, _min_max )
+{
+    axis_ = min_max / 2;
+    dt_ov_dx_ = dt / params.cell_length[axis_];
+    
+    unsigned int n_p = params.n_space[axis_] + 1 + 2*params.oversize[axis_];
+    profile_.init( min_max%2, n_p, params.oversize[axis_], params.number_of_pml_cells[axis_],
+                   params.cell_length[axis_], dt, params.pml_reflection, params.pml_kappa_max, params.pml_alpha_max );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Pairs of components depending on the direction, from Maxwell's equations (same sign in Ampere and Faraday)
+//   x : dEy/dt = - dBz/dx   and   dEz/dt = + dBy/dx
+//   y : dEx/dt = + dBz/dy   and   dEz/dt = - dBx/dy
+//   z : dEx/dt = - dBy/dz   and   dEy/dt = + dBx/dz
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagnBC_PML::getPair( ElectroMagn *EMfields, unsigned int ipair, Field *&E, Field *&B, double &sign, unsigned int &B_direction )
+{
+    if( axis_ == 0 ) {
+        E    = ipair==0 ? EMfields->Ey_ : EMfields->Ez_;
+        B    = ipair==0 ? EMfields->Bz_ : EMfields->By_;
+        sign = ipair==0 ? -1. : 1.;
+        B_direction = ipair==0 ? 2 : 1;
+    } else if( axis_ == 1 ) {
+        E    = ipair==0 ? EMfields->Ex_ : EMfields->Ez_;
+        B    = ipair==0 ? EMfields->Bz_ : EMfields->Bx_;
+        sign = ipair==0 ? 1. : -1.;
+        B_direction = ipair==0 ? 2 : 0;
+    } else {
+        E    = ipair==0 ? EMfields->Ex_ : EMfields->Ey_;
+        B    = ipair==0 ? EMfields->By_ : EMfields->Bx_;
+        sign = ipair==0 ? -1. : 1.;
+        B_direction = ipair==0 ? 1 : 0;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Dimensions of the fields padded to 3, and allocation of the memory variables at the first call
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagnBC_PML::getDimensions( unsigned int ipair, Field *E, Field *B, unsigned int E_dims[3], unsigned int B_dims[3] )
+{
+    for( unsigned int d=0; d<3; d++ ) {
+        E_dims[d] = d < E->dims_.size() ? E->dims_[d] : 1;
+        B_dims[d] = d < B->dims_.size() ? B->dims_[d] : 1;
+    }
+    if( psiE_[ipair].empty() ) {
+        psiE_[ipair].resize( E_dims[0]*E_dims[1]*E_dims[2] / E_dims[axis_] * profile_.layerSize( false ), 0. );
+        psiB_[ipair].resize( B_dims[0]*B_dims[1]*B_dims[2] / B_dims[axis_] * profile_.layerSize( true ), 0. );
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Correct E on the primal points of the layer, after Maxwell-Ampere (which is solved on all points)
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagnBC_PML::correctE( ElectroMagn *EMfields, Patch *patch )
+{
+    if( ! patch->locateOnBorders( axis_, min_max%2 ) ) {
+        return;
+    }
+    
+    for( unsigned int ipair=0; ipair<2; ipair++ ) {
+        Field *E, *B;
+        double sign;
+        unsigned int B_direction, E_dims[3], B_dims[3];
+        getPair( EMfields, ipair, E, B, sign, B_direction );
+        getDimensions( ipair, E, B, E_dims, B_dims );
+        
+        unsigned int first[3] = { 0, 0, 0 };
+        profile_.correct( false, E->data_, B->data_, psiE_[ipair].data(), axis_, E_dims, first, E_dims, sign*dt_ov_dx_ );
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Correct B on the dual points of the layer, after Maxwell-Faraday
+// As Maxwell-Faraday, the first and last points are skipped in the transverse directions where B is dual
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagnBC_PML::correctB( ElectroMagn *EMfields, Patch *patch )
+{
+    if( ! patch->locateOnBorders( axis_, min_max%2 ) ) {
+        return;
+    }
+    
+    for( unsigned int ipair=0; ipair<2; ipair++ ) {
+        Field *E, *B;
+        double sign;
+        unsigned int B_direction, E_dims[3], B_dims[3];
+        getPair( EMfields, ipair, E, B, sign, B_direction );
+        getDimensions( ipair, E, B, E_dims, B_dims );
+        
+        unsigned int first[3], last[3];
+        for( unsigned int d=0; d<3; d++ ) {
+            bool dual = d < B->dims_.size() && d != B_direction;
+            first[d] = dual ? 1 : 0;
+            last[d] = dual ? B_dims[d]-1 : B_dims[d];
+        }
+        profile_.correct( true, B->data_, E->data_, psiB_[ipair].data(), axis_, B_dims, first, last, sign*dt_ov_dx_ );
+    }
+}
+
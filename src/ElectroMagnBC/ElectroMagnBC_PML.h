@@ -0,0 +1,50 @@
+
+#ifndef ELECTROMAGNBC_PML_H
+#define ELECTROMAGNBC_PML_H
+
+#include "ElectroMagnBC.h"
+#include "PML.h"
+
+class Params;
+class ElectroMagn;
+
+//! Convolutional PML on one side of a 2D or 3D cartesian box.
+//! The layer is made of the last cells of the box, where the E and B computed by Yee's scheme
+//! are corrected just after Maxwell-Ampere and Maxwell-Faraday. The box border behind the layer
+//! is left unchanged, so that the waves attenuated in the layer are reflected and attenuated again.
+class ElectroMagnBC_PML : public ElectroMagnBC
+{
+public:
+    ElectroMagnBC_PML( Params &params, Patch *patch, unsigned int _min_max );
+    ~ElectroMagnBC_PML() {};
+    
+    void apply( ElectroMagn *, double, Patch * ) override {};
+    
+    void correctE( ElectroMagn *EMfields, Patch *patch ) override;
+    void correctB( ElectroMagn *EMfields, Patch *patch ) override;
+    
+private:
+
+    //! Components of E and B coupled by the derivative along the direction of the layer,
+    //! sign of this derivative in Maxwell's equations, and direction of the B component
+    void getPair( ElectroMagn *EMfields, unsigned int ipair, Field *&E, Field *&B, double &sign, unsigned int &B_direction );
+    
+    //! Dimensions of a field padded to 3, and allocation of the memory variables at the first call
+    void getDimensions( unsigned int ipair, Field *E, Field *B, unsigned int E_dims[3], unsigned int B_dims[3] );
+    
+    //! Direction of the layer
+    unsigned int axis_;
+    
+    //! Ratio of the time-step by the spatial-step along the direction of the layer
+    double dt_ov_dx_;
+    
+    //! Coefficients of the layer
+    PMLProfile profile_;
+    
+    //! Memory variables of the two pairs of components, allocated at the first correction
+    std::vector<double> psiE_[2], psiB_[2];
+    
+};
+
+#endif
+
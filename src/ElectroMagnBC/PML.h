@@ -0,0 +1,141 @@
+
+#ifndef PML_H
+#define PML_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+//! Profile of a convolutional perfectly matched layer (CFS-CPML) along one direction, on one side of the box.
+//! The layer occupies the last cells inside the box (and the ghost cells beyond). Yee's scheme is left
+//! unchanged: after each half-step, a field F updated by s*dt*dG/dx gets the additional term
+//! s*dt*( (1/kappa-1)*dG/dx + psi ), where the memory variable psi = b*psi + a*dG/dx is the discrete
+//! convolution of the stretched coordinates. The coefficients a, b and (1/kappa-1) are tabulated on the
+//! primal and dual points of the layer, and psi (multiplied by dx) is stored by the boundary condition.
+class PMLProfile
+{
+public:
+    PMLProfile() : primal_start_( 0 ), primal_size_( 0 ), dual_start_( 0 ), dual_size_( 0 ) {};
+
+    //! n_p: number of primal points of the patch along the direction (ghost cells included)
+    //! oversize: number of ghost cells, number_of_cells: thickness of the layer inside the box
+    //! dx, dt: cell length and timestep, reflection: theoretical reflection coefficient at normal incidence
+    //! kappa_max, alpha_max: maximum coordinate stretching and complex frequency shift
+    void init( unsigned int side, unsigned int n_p, unsigned int oversize, unsigned int number_of_cells,
+               double dx, double dt, double reflection, double kappa_max, double alpha_max )
+    {
+        // cubic grading of sigma and kappa, linear grading of alpha (maximum at the inner edge)
+        const double m = 3.;
+        const double N = number_of_cells;
+        const double sigma_max = -( m+1. )*std::log( reflection )/( 2.*N*dx );
+
+        // Distance to the boundary in cells, for the local index i shifted by -0.5 on the dual grid
+        const double boundary = side==0 ? oversize : n_p-1-oversize;
+        for( unsigned int dual=0; dual<2; dual++ ) {
+            std::vector<double> &a = dual ? a_dual_ : a_primal_;
+            std::vector<double> &b = dual ? b_dual_ : b_primal_;
+            std::vector<double> &c = dual ? c_dual_ : c_primal_;
+            unsigned int n = n_p + dual;
+            unsigned int start = n, end = 0;
+            std::vector<double> u( n );
+            for( unsigned int i=0; i<n; i++ ) {
+                double position = i - 0.5*dual;
+                double distance = side==0 ? position - boundary : boundary - position;
+                u[i] = std::min( ( N - distance )/N, 1. );
+                if( u[i] > 0. ) {
+                    start = std::min( start, i );
+                    end = i+1;
+                }
+            }
+            a.resize( end>start ? end-start : 0 );
+            b.resize( a.size() );
+            c.resize( a.size() );
+            for( unsigned int i=0; i<a.size(); i++ ) {
+                double um = std::pow( u[start+i], m );
+                double sigma = sigma_max*um;
+                double kappa = 1. + ( kappa_max-1. )*um;
+                double alpha = alpha_max*( 1.-u[start+i] );
+                b[i] = std::exp( -( sigma/kappa + alpha )*dt );
+                a[i] = sigma > 0. ? sigma/( sigma*kappa + kappa*kappa*alpha )*( b[i]-1. ) : 0.;
+                c[i] = 1./kappa - 1.;
+            }
+            ( dual ? dual_start_ : primal_start_ ) = start;
+            ( dual ? dual_size_ : primal_size_ ) = a.size();
+        }
+    };
+
+    //! Number of points of the layer on the primal or dual grid
+    inline unsigned int layerSize( bool dual ) const
+    {
+        return dual ? dual_size_ : primal_size_;
+    }
+
+    //! Correction of the field F, advanced in Yee's scheme by s*dt*dG/dx along the direction `axis`
+    //! F and G are linearized as [dims[0]][dims[1]][dims[2]] with the dimensions of F, G having one
+    //! more point along the direction if F is primal, or one less if F is dual. Only the points
+    //! [first, last) in the transverse directions and, for a dual F, the points where Maxwell-Faraday
+    //! is solved along the direction are corrected.
+    //! psi has the dimensions of F, with layerSize( dual ) points along the direction.
+    template<typename T>
+    void correct( bool dual, T *F, const T *G, T *psi, unsigned int axis, const unsigned int dims[3],
+                  const unsigned int first[3], const unsigned int last[3], double s_dt_ov_dx ) const
+    {
+        const std::vector<double> &a = dual ? a_dual_ : a_primal_;
+        const std::vector<double> &b = dual ? b_dual_ : b_primal_;
+        const std::vector<double> &c = dual ? c_dual_ : c_primal_;
+        const unsigned int start = dual ? dual_start_ : primal_start_;
+
+        unsigned int lo[3], hi[3], gdims[3], pdims[3];
+        for( unsigned int d=0; d<3; d++ ) {
+            lo[d] = first[d];
+            hi[d] = last[d];
+            gdims[d] = dims[d];
+            pdims[d] = dims[d];
+        }
+        lo[axis] = start;
+        hi[axis] = start + a.size();
+        if( dual ) {
+            lo[axis] = std::max( lo[axis], 1u );
+            hi[axis] = std::min( hi[axis], dims[axis]-1 );
+            gdims[axis] = dims[axis]-1;
+        } else {
+            gdims[axis] = dims[axis]+1;
+        }
+        pdims[axis] = a.size();
+
+        // The derivative is G(i+1)-G(i) for a primal F and G(i)-G(i-1) for a dual F
+        const unsigned int gstride = axis==0 ? gdims[1]*gdims[2] : ( axis==1 ? gdims[2] : 1 );
+        const unsigned int gp = dual ? 0 : gstride;
+        const unsigned int gm = dual ? gstride : 0;
+        const unsigned int off[3] = { axis==0 ? start : 0, axis==1 ? start : 0, axis==2 ? start : 0 };
+
+        for( unsigned int i0=lo[0]; i0<hi[0]; i0++ ) {
+            for( unsigned int i1=lo[1]; i1<hi[1]; i1++ ) {
+                T *__restrict__ f = &F[( i0*dims[1] + i1 )*dims[2]];
+                const T *__restrict__ g_p = &G[( i0*gdims[1] + i1 )*gdims[2] + gp];
+                const T *__restrict__ g_m = &G[( i0*gdims[1] + i1 )*gdims[2] - gm];
+                T *__restrict__ p = &psi[( ( i0-off[0] )*pdims[1] + i1-off[1] )*pdims[2]];
+                const unsigned int l01 = axis==0 ? i0-start : i1-start;
+                #pragma omp simd
+                for( unsigned int i2=lo[2]; i2<hi[2]; i2++ ) {
+                    const unsigned int l = axis==2 ? i2-start : l01;
+                    const T d = g_p[i2] - g_m[i2];
+                    T &q = p[i2-off[2]];
+                    q = b[l]*q + a[l]*d;
+                    f[i2] += s_dt_ov_dx*( c[l]*d + q );
+                }
+            }
+        }
+    };
+
+private:
+    //! First local index and number of the primal and dual points in the layer
+    unsigned int primal_start_, primal_size_;
+    unsigned int dual_start_, dual_size_;
+
+    //! Coefficients a, b and 1/kappa-1 on the primal and dual points of the layer
+    std::vector<double> a_primal_, b_primal_, c_primal_;
+    std::vector<double> a_dual_, b_dual_, c_dual_;
+};
+
+#endif
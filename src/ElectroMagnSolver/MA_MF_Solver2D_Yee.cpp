@@ -0,0 +1,110 @@
+
+#include "MA_MF_Solver2D_Yee.h"
+
+#include <cstring>
+
+#include "ElectroMagn.h"
+#include "Field2D.h"
+
+MA_MF_Solver2D_Yee::MA_MF_Solver2D_Yee( Params &params )
+    : Solver2D( params )
+{
+}
+
+MA_MF_Solver2D_Yee::~MA_MF_Solver2D_Yee()
+{
+}
+
+void MA_MF_Solver2D_Yee::operator()( ElectroMagn *fields )
+{
+    // Static-cast of the fields
+    Field2D *Ex2D = static_cast<Field2D *>( fields->Ex_ );
+    Field2D *Ey2D = static_cast<Field2D *>( fields->Ey_ );
+    Field2D *Ez2D = static_cast<Field2D *>( fields->Ez_ );
+    Field2D *Bx2D = static_cast<Field2D *>( fields->Bx_ );
+    Field2D *By2D = static_cast<Field2D *>( fields->By_ );
+    Field2D *Bz2D = static_cast<Field2D *>( fields->Bz_ );
+    Field2D *Bx2D_m = static_cast<Field2D *>( fields->Bx_m );
+    Field2D *By2D_m = static_cast<Field2D *>( fields->By_m );
+    Field2D *Bz2D_m = static_cast<Field2D *>( fields->Bz_m );
+    Field2D *Jx2D = static_cast<Field2D *>( fields->Jx_ );
+    Field2D *Jy2D = static_cast<Field2D *>( fields->Jy_ );
+    Field2D *Jz2D = static_cast<Field2D *>( fields->Jz_ );
+    
+    // E in the row i needs B in the rows i and i+1, and B in the row i needs E in the rows i and i-1.
+    // At the step i, B is saved and E is advanced in the row i (B of the row i+1 is not advanced yet),
+    // then B is advanced in the row i, while the rows i-1 and i are still in cache.
+    for( unsigned int i=0 ; i<nx_d ; i++ ) {
+        double *__restrict__ Ex = &( *Ex2D )( i, 0 );
+        double *__restrict__ By = &( *By2D )( i, 0 );
+        double *__restrict__ Bz = &( *Bz2D )( i, 0 );
+        
+        // Save B in the row i
+        if( i<nx_p ) {
+            memcpy( &( *Bx2D_m )( i, 0 ), &( *Bx2D )( i, 0 ), ny_d*sizeof( double ) );
+        }
+        memcpy( &( *By2D_m )( i, 0 ), By, ny_p*sizeof( double ) );
+        memcpy( &( *Bz2D_m )( i, 0 ), Bz, ny_d*sizeof( double ) );
+        
+        // Electric field Ex^(d,p)
+        {
+            const double *__restrict__ Jx = &( *Jx2D )( i, 0 );
+            #pragma omp simd
+            for( unsigned int j=0 ; j<ny_p ; j++ ) {
+                Ex[j] += -dt*Jx[j] + dt_ov_dy * ( Bz[j+1] - Bz[j] );
+            }
+        }
+        
+        if( i<nx_p ) {
+            double *__restrict__ Ey = &( *Ey2D )( i, 0 );
+            double *__restrict__ Ez = &( *Ez2D )( i, 0 );
+            double *__restrict__ Bx = &( *Bx2D )( i, 0 );
+            const double *__restrict__ Jy = &( *Jy2D )( i, 0 );
+            const double *__restrict__ Jz = &( *Jz2D )( i, 0 );
+            const double *__restrict__ By_ip = &( *By2D )( i+1, 0 );
+            const double *__restrict__ Bz_ip = &( *Bz2D )( i+1, 0 );
+            
+            // Electric field Ey^(p,d)
+            #pragma omp simd
+            for( unsigned int j=0 ; j<ny_d ; j++ ) {
+                Ey[j] += -dt*Jy[j] - dt_ov_dx * ( Bz_ip[j] - Bz[j] );
+            }
+            
+            // Electric field Ez^(p,p)
+            #pragma omp simd
+            for( unsigned int j=0 ; j<ny_p ; j++ ) {
+                Ez[j] += -dt*Jz[j]
+                         +               dt_ov_dx * ( By_ip[j] - By[j] )
+                         -               dt_ov_dy * ( Bx[j+1] - Bx[j] );
+            }
+            
+            // Magnetic field Bx^(p,d)
+            #pragma omp simd
+            for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
+                Bx[j] -= dt_ov_dy * ( Ez[j] - Ez[j-1] );
+            }
+        }
+        
+        if( i>0 && i<nx_d-1 ) {
+            const double *__restrict__ Ey = &( *Ey2D )( i, 0 );
+            const double *__restrict__ Ey_im = &( *Ey2D )( i-1, 0 );
+            const double *__restrict__ Ez = &( *Ez2D )( i, 0 );
+            const double *__restrict__ Ez_im = &( *Ez2D )( i-1, 0 );
+            
+            // Magnetic field By^(d,p)
+            #pragma omp simd
+            for( unsigned int j=0 ; j<ny_p ; j++ ) {
+                By[j] += dt_ov_dx * ( Ez[j] - Ez_im[j] );
+            }
+            
+            // Magnetic field Bz^(d,d)
+            #pragma omp simd
+            for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
+                Bz[j] += dt_ov_dy * ( Ex[j] - Ex[j-1] )
+                         -               dt_ov_dx * ( Ey[j] - Ey_im[j] );
+            }
+        }
+    }
+    
+}
+
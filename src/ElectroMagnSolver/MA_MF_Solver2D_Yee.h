@@ -0,0 +1,28 @@
+#ifndef MA_MF_SOLVER2D_YEE_H
+#define MA_MF_SOLVER2D_YEE_H
+
+#include "Solver2D.h"
+class ElectroMagn;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class MA_MF_Solver2D_Yee
+//! Saves B in B_m, then solves Maxwell-Ampere and Maxwell-Faraday (Yee) in a single sweep over the x rows:
+//! the fields are read from memory once per timestep instead of three times.
+//! The results are identical to saveMagneticFields, MA_Solver2D_norm and MF_Solver2D_Yee in turn.
+//  --------------------------------------------------------------------------------------------------------------------
+class MA_MF_Solver2D_Yee : public Solver2D
+{
+
+public:
+    MA_MF_Solver2D_Yee( Params &params );
+    virtual ~MA_MF_Solver2D_Yee();
+    
+    //! Overloading of () operator
+    virtual void operator()( ElectroMagn *fields );
+    
+protected:
+
+};//END class
+
+#endif
+
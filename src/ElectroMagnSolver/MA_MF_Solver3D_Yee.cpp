@@ -0,0 +1,135 @@
+
+#include "MA_MF_Solver3D_Yee.h"
+
+#include <cstring>
+
+#include "ElectroMagn.h"
+#include "Field3D.h"
+
+MA_MF_Solver3D_Yee::MA_MF_Solver3D_Yee( Params &params )
+    : Solver3D( params )
+{
+}
+
+MA_MF_Solver3D_Yee::~MA_MF_Solver3D_Yee()
+{
+}
+
+void MA_MF_Solver3D_Yee::operator()( ElectroMagn *fields )
+{
+    // Static-cast of the fields
+    Field3D *Ex3D = static_cast<Field3D *>( fields->Ex_ );
+    Field3D *Ey3D = static_cast<Field3D *>( fields->Ey_ );
+    Field3D *Ez3D = static_cast<Field3D *>( fields->Ez_ );
+    Field3D *Bx3D = static_cast<Field3D *>( fields->Bx_ );
+    Field3D *By3D = static_cast<Field3D *>( fields->By_ );
+    Field3D *Bz3D = static_cast<Field3D *>( fields->Bz_ );
+    Field3D *Bx3D_m = static_cast<Field3D *>( fields->Bx_m );
+    Field3D *By3D_m = static_cast<Field3D *>( fields->By_m );
+    Field3D *Bz3D_m = static_cast<Field3D *>( fields->Bz_m );
+    Field3D *Jx3D = static_cast<Field3D *>( fields->Jx_ );
+    Field3D *Jy3D = static_cast<Field3D *>( fields->Jy_ );
+    Field3D *Jz3D = static_cast<Field3D *>( fields->Jz_ );
+    
+    // E in the plane i needs B in the planes i and i+1, and B in the plane i needs E in the planes i and i-1.
+    // At the step i, B is saved and E is advanced in the plane i (B of the plane i+1 is not advanced yet),
+    // then B is advanced in the plane i, while the planes i-1 and i are still in cache.
+    for( unsigned int i=0 ; i<nx_d ; i++ ) {
+    
+        // Save B in the plane i
+        if( i<nx_p ) {
+            memcpy( &( *Bx3D_m )( i, 0, 0 ), &( *Bx3D )( i, 0, 0 ), ny_d*nz_d*sizeof( double ) );
+        }
+        memcpy( &( *By3D_m )( i, 0, 0 ), &( *By3D )( i, 0, 0 ), ny_p*nz_d*sizeof( double ) );
+        memcpy( &( *Bz3D_m )( i, 0, 0 ), &( *Bz3D )( i, 0, 0 ), ny_d*nz_p*sizeof( double ) );
+        
+        // Electric field Ex^(d,p,p)
+        for( unsigned int j=0 ; j<ny_p ; j++ ) {
+            double *__restrict__ Ex = &( *Ex3D )( i, j, 0 );
+            const double *__restrict__ Jx = &( *Jx3D )( i, j, 0 );
+            const double *__restrict__ By = &( *By3D )( i, j, 0 );
+            const double *__restrict__ Bz = &( *Bz3D )( i, j, 0 );
+            const double *__restrict__ Bz_jp = &( *Bz3D )( i, j+1, 0 );
+            #pragma omp simd
+            for( unsigned int k=0 ; k<nz_p ; k++ ) {
+                Ex[k] += -dt*Jx[k]
+                         +                 dt_ov_dy * ( Bz_jp[k] - Bz[k] )
+                         -                 dt_ov_dz * ( By[k+1] - By[k] );
+            }
+        }
+        
+        if( i<nx_p ) {
+            // Electric field Ey^(p,d,p)
+            for( unsigned int j=0 ; j<ny_d ; j++ ) {
+                double *__restrict__ Ey = &( *Ey3D )( i, j, 0 );
+                const double *__restrict__ Jy = &( *Jy3D )( i, j, 0 );
+                const double *__restrict__ Bx = &( *Bx3D )( i, j, 0 );
+                const double *__restrict__ Bz = &( *Bz3D )( i, j, 0 );
+                const double *__restrict__ Bz_ip = &( *Bz3D )( i+1, j, 0 );
+                #pragma omp simd
+                for( unsigned int k=0 ; k<nz_p ; k++ ) {
+                    Ey[k] += -dt*Jy[k]
+                             -                  dt_ov_dx * ( Bz_ip[k] - Bz[k] )
+                             +                  dt_ov_dz * ( Bx[k+1] - Bx[k] );
+                }
+            }
+            
+            // Electric field Ez^(p,p,d)
+            for( unsigned int j=0 ; j<ny_p ; j++ ) {
+                double *__restrict__ Ez = &( *Ez3D )( i, j, 0 );
+                const double *__restrict__ Jz = &( *Jz3D )( i, j, 0 );
+                const double *__restrict__ Bx = &( *Bx3D )( i, j, 0 );
+                const double *__restrict__ Bx_jp = &( *Bx3D )( i, j+1, 0 );
+                const double *__restrict__ By = &( *By3D )( i, j, 0 );
+                const double *__restrict__ By_ip = &( *By3D )( i+1, j, 0 );
+                #pragma omp simd
+                for( unsigned int k=0 ; k<nz_d ; k++ ) {
+                    Ez[k] += -dt*Jz[k]
+                             +                  dt_ov_dx * ( By_ip[k] - By[k] )
+                             -                  dt_ov_dy * ( Bx_jp[k] - Bx[k] );
+                }
+            }
+            
+            // Magnetic field Bx^(p,d,d)
+            for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
+                double *__restrict__ Bx = &( *Bx3D )( i, j, 0 );
+                const double *__restrict__ Ey = &( *Ey3D )( i, j, 0 );
+                const double *__restrict__ Ez = &( *Ez3D )( i, j, 0 );
+                const double *__restrict__ Ez_jm = &( *Ez3D )( i, j-1, 0 );
+                #pragma omp simd
+                for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
+                    Bx[k] += -dt_ov_dy * ( Ez[k] - Ez_jm[k] ) + dt_ov_dz * ( Ey[k] - Ey[k-1] );
+                }
+            }
+        }
+        
+        if( i>0 && i<nx_d-1 ) {
+            // Magnetic field By^(d,p,d)
+            for( unsigned int j=0 ; j<ny_p ; j++ ) {
+                double *__restrict__ By = &( *By3D )( i, j, 0 );
+                const double *__restrict__ Ex = &( *Ex3D )( i, j, 0 );
+                const double *__restrict__ Ez = &( *Ez3D )( i, j, 0 );
+                const double *__restrict__ Ez_im = &( *Ez3D )( i-1, j, 0 );
+                #pragma omp simd
+                for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
+                    By[k] += -dt_ov_dz * ( Ex[k] - Ex[k-1] ) + dt_ov_dx * ( Ez[k] - Ez_im[k] );
+                }
+            }
+            
+            // Magnetic field Bz^(d,d,p)
+            for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
+                double *__restrict__ Bz = &( *Bz3D )( i, j, 0 );
+                const double *__restrict__ Ex = &( *Ex3D )( i, j, 0 );
+                const double *__restrict__ Ex_jm = &( *Ex3D )( i, j-1, 0 );
+                const double *__restrict__ Ey = &( *Ey3D )( i, j, 0 );
+                const double *__restrict__ Ey_im = &( *Ey3D )( i-1, j, 0 );
+                #pragma omp simd
+                for( unsigned int k=0 ; k<nz_p ; k++ ) {
+                    Bz[k] += -dt_ov_dx * ( Ey[k] - Ey_im[k] ) + dt_ov_dy * ( Ex[k] - Ex_jm[k] );
+                }
+            }
+        }
+    }
+    
+}
+
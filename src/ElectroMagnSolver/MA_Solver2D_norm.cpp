@@ -26,26 +26,49 @@ void MA_Solver2D_norm::operator()( ElectroMagn *fields )
     Field2D *Jx2D = static_cast<Field2D *>( fields->Jx_ );
     Field2D *Jy2D = static_cast<Field2D *>( fields->Jy_ );
     Field2D *Jz2D = static_cast<Field2D *>( fields->Jz_ );
+    // The loops go through rows of the linearized arrays with restrict pointers,
+    // so that the inner loops are vectorized. The rows of large regions are shared among the threads
+    
+    const bool threaded = Tools::shareAmongThreads( nx_d*ny_d );
+    
     // Electric field Ex^(d,p)
+    #pragma omp parallel for schedule(static) if( threaded )
     for( unsigned int i=0 ; i<nx_d ; i++ ) {
+        double *__restrict__ Ex = &( *Ex2D )( i, 0 );
+        const double *__restrict__ Jx = &( *Jx2D )( i, 0 );
+        const double *__restrict__ Bz = &( *Bz2D )( i, 0 );
+        #pragma omp simd
         for( unsigned int j=0 ; j<ny_p ; j++ ) {
-            ( *Ex2D )( i, j ) += -dt*( *Jx2D )( i, j ) + dt_ov_dy * ( ( *Bz2D )( i, j+1 ) - ( *Bz2D )( i, j ) );
+            Ex[j] += -dt*Jx[j] + dt_ov_dy * ( Bz[j+1] - Bz[j] );
         }
     }
     
     // Electric field Ey^(p,d)
+    #pragma omp parallel for schedule(static) if( threaded )
     for( unsigned int i=0 ; i<nx_p ; i++ ) {
+        double *__restrict__ Ey = &( *Ey2D )( i, 0 );
+        const double *__restrict__ Jy = &( *Jy2D )( i, 0 );
+        const double *__restrict__ Bz = &( *Bz2D )( i, 0 );
+        const double *__restrict__ Bz_ip = &( *Bz2D )( i+1, 0 );
+        #pragma omp simd
         for( unsigned int j=0 ; j<ny_d ; j++ ) {
-            ( *Ey2D )( i, j ) += -dt*( *Jy2D )( i, j ) - dt_ov_dx * ( ( *Bz2D )( i+1, j ) - ( *Bz2D )( i, j ) );
+            Ey[j] += -dt*Jy[j] - dt_ov_dx * ( Bz_ip[j] - Bz[j] );
         }
     }
     
     // Electric field Ez^(p,p)
+    #pragma omp parallel for schedule(static) if( threaded )
     for( unsigned int i=0 ;  i<nx_p ; i++ ) {
+        double *__restrict__ Ez = &( *Ez2D )( i, 0 );
+        const double *__restrict__ Jz = &( *Jz2D )( i, 0 );
+        const double *__restrict__ Bx = &( *Bx2D )( i, 0 );
+        const double *__restrict__ By = &( *By2D )( i, 0 );
+        const double *__restrict__ By_ip = &( *By2D )( i+1, 0 );
+        #pragma omp simd
         for( unsigned int j=0 ; j<ny_p ; j++ ) {
-            ( *Ez2D )( i, j ) += -dt*( *Jz2D )( i, j )
-                                 +               dt_ov_dx * ( ( *By2D )( i+1, j ) - ( *By2D )( i, j ) )
-                                 -               dt_ov_dy * ( ( *Bx2D )( i, j+1 ) - ( *Bx2D )( i, j ) );
+            Ez[j] += -dt*Jz[j]
+                     +               dt_ov_dx * ( By_ip[j] - By[j] )
+                     -               dt_ov_dy * ( Bx[j+1] - Bx[j] );
         }
     }
     
@@ -27,35 +27,62 @@ void MA_Solver3D_norm::operator()( ElectroMagn *fields )
     Field3D *Jy3D = static_cast<Field3D *>( fields->Jy_ );
     Field3D *Jz3D = static_cast<Field3D *>( fields->Jz_ );
     
+    // The loops go through rows of the linearized arrays with restrict pointers,
+    // so that the inner loops are vectorized. The rows of large regions are shared among the threads
+    
+    const bool threaded = Tools::shareAmongThreads( nx_d*ny_d*nz_d );
+    
     // Electric field Ex^(d,p,p)
+    #pragma omp parallel for collapse(2) schedule(static) if( threaded )
     for( unsigned int i=0 ; i<nx_d ; i++ ) {
         for( unsigned int j=0 ; j<ny_p ; j++ ) {
+            double *__restrict__ Ex = &( *Ex3D )( i, j, 0 );
+            const double *__restrict__ Jx = &( *Jx3D )( i, j, 0 );
+            const double *__restrict__ By = &( *By3D )( i, j, 0 );
+            const double *__restrict__ Bz = &( *Bz3D )( i, j, 0 );
+            const double *__restrict__ Bz_jp = &( *Bz3D )( i, j+1, 0 );
+            #pragma omp simd
             for( unsigned int k=0 ; k<nz_p ; k++ ) {
-                ( *Ex3D )( i, j, k ) += -dt*( *Jx3D )( i, j, k )
-                                        +                 dt_ov_dy * ( ( *Bz3D )( i, j+1, k ) - ( *Bz3D )( i, j, k ) )
-                                        -                 dt_ov_dz * ( ( *By3D )( i, j, k+1 ) - ( *By3D )( i, j, k ) );
+                Ex[k] += -dt*Jx[k]
+                         +                 dt_ov_dy * ( Bz_jp[k] - Bz[k] )
+                         -                 dt_ov_dz * ( By[k+1] - By[k] );
             }
         }
     }
     
     // Electric field Ey^(p,d,p)
+    #pragma omp parallel for collapse(2) schedule(static) if( threaded )
     for( unsigned int i=0 ; i<nx_p ; i++ ) {
         for( unsigned int j=0 ; j<ny_d ; j++ ) {
+            double *__restrict__ Ey = &( *Ey3D )( i, j, 0 );
+            const double *__restrict__ Jy = &( *Jy3D )( i, j, 0 );
+            const double *__restrict__ Bx = &( *Bx3D )( i, j, 0 );
+            const double *__restrict__ Bz = &( *Bz3D )( i, j, 0 );
+            const double *__restrict__ Bz_ip = &( *Bz3D )( i+1, j, 0 );
+            #pragma omp simd
             for( unsigned int k=0 ; k<nz_p ; k++ ) {
-                ( *Ey3D )( i, j, k ) += -dt*( *Jy3D )( i, j, k )
-                                        -                  dt_ov_dx * ( ( *Bz3D )( i+1, j, k ) - ( *Bz3D )( i, j, k ) )
-                                        +                  dt_ov_dz * ( ( *Bx3D )( i, j, k+1 ) - ( *Bx3D )( i, j, k ) );
+                Ey[k] += -dt*Jy[k]
+                         -                  dt_ov_dx * ( Bz_ip[k] - Bz[k] )
+                         +                  dt_ov_dz * ( Bx[k+1] - Bx[k] );
             }
         }
     }
     
     // Electric field Ez^(p,p,d)
+    #pragma omp parallel for collapse(2) schedule(static) if( threaded )
     for( unsigned int i=0 ;  i<nx_p ; i++ ) {
         for( unsigned int j=0 ; j<ny_p ; j++ ) {
+            double *__restrict__ Ez = &( *Ez3D )( i, j, 0 );
+            const double *__restrict__ Jz = &( *Jz3D )( i, j, 0 );
+            const double *__restrict__ Bx = &( *Bx3D )( i, j, 0 );
+            const double *__restrict__ Bx_jp = &( *Bx3D )( i, j+1, 0 );
+            const double *__restrict__ By = &( *By3D )( i, j, 0 );
+            const double *__restrict__ By_ip = &( *By3D )( i+1, j, 0 );
+            #pragma omp simd
             for( unsigned int k=0 ; k<nz_d ; k++ ) {
-                ( *Ez3D )( i, j, k ) += -dt*( *Jz3D )( i, j, k )
-                                        +                  dt_ov_dx * ( ( *By3D )( i+1, j, k ) - ( *By3D )( i, j, k ) )
-                                        -                  dt_ov_dy * ( ( *Bx3D )( i, j+1, k ) - ( *Bx3D )( i, j, k ) );
+                Ez[k] += -dt*Jz[k]
+                         +                  dt_ov_dx * ( By_ip[k] - By[k] )
+                         -                  dt_ov_dy * ( Bx_jp[k] - Bx[k] );
             }
         }
     }
@@ -16,6 +16,8 @@ MA_SolverAM_norm::~MA_SolverAM_norm()
 
 void MA_SolverAM_norm::operator()( ElectroMagn *fields )
 {
+    const bool threaded = Tools::shareAmongThreads( nl_d*nr_d );
+    
     for( unsigned int imode=0 ; imode<Nmode ; imode++ ) {
     
         // Static-cast of the fields_SolverAM_norm.cpp
@@ -34,6 +36,7 @@ void MA_SolverAM_norm::operator()( ElectroMagn *fields )
         //double *invRd = ( static_cast<ElectroMagnAM *>( fields ) )->invRd;
         
         // Electric field Elr^(d,p)
+        #pragma omp parallel for schedule(static) if( threaded )
         for( unsigned int i=0 ; i<nl_d ; i++ ) {
             for( unsigned int j=isYmin*3 ; j<nr_p ; j++ ) {
                 ( *El )( i, j ) += -dt*( *Jl )( i, j )
@@ -41,6 +44,7 @@ void MA_SolverAM_norm::operator()( ElectroMagn *fields )
                                    +                 Icpx*dt*( double )imode/( ( j_glob+j )*dr )*( *Br )( i, j );
             }
         }
+        #pragma omp parallel for schedule(static) if( threaded )
         for( unsigned int i=0 ; i<nl_p ; i++ ) {
             for( unsigned int j=isYmin*3 ; j<nr_d ; j++ ) {
                 ( *Er )( i, j ) += -dt*( *Jr )( i, j )
@@ -49,6 +53,7 @@ void MA_SolverAM_norm::operator()( ElectroMagn *fields )
                                    
             }
         }
+        #pragma omp parallel for schedule(static) if( threaded )
         for( unsigned int i=0 ;  i<nl_p ; i++ ) {
             for( unsigned int j=isYmin*3 ; j<nr_p ; j++ ) {
                 ( *Et )( i, j ) += -dt*( *Jt )( i, j )
@@ -34,39 +34,47 @@ void MF_Solver2D_Yee::operator()( ElectroMagn *fields )
     Field2D *By2D = static_cast<Field2D *>( fields->By_ );
     Field2D *Bz2D = static_cast<Field2D *>( fields->Bz_ );
     
+    // The loops go through rows of the linearized arrays with restrict pointers,
+    // so that the inner loops are vectorized. The rows of large regions are shared among the threads
+    
+    const bool threaded = Tools::shareAmongThreads( nx_d*ny_d );
+    
     // Magnetic field Bx^(p,d)
-    //cout << "nx_p,nx_d-1" << nx_p << " " << nx_d-1 ;
-    //{
     {
+        double *__restrict__ Bx = &( *Bx2D )( 0, 0 );
+        const double *__restrict__ Ez = &( *Ez2D )( 0, 0 );
         #pragma omp simd
         for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
-            ( *Bx2D )( 0, j ) -= dt_ov_dy * ( ( *Ez2D )( 0, j ) - ( *Ez2D )( 0, j-1 ) );
+            Bx[j] -= dt_ov_dy * ( Ez[j] - Ez[j-1] );
         }
     }
-    //    for (unsigned int i=0 ; i<nx_p;  i++) {
+    #pragma omp parallel for schedule(static) if( threaded )
     for( unsigned int i=1 ; i<nx_d-1;  i++ ) {
+        double *__restrict__ Bx = &( *Bx2D )( i, 0 );
+        double *__restrict__ By = &( *By2D )( i, 0 );
+        double *__restrict__ Bz = &( *Bz2D )( i, 0 );
+        const double *__restrict__ Ex = &( *Ex2D )( i, 0 );
+        const double *__restrict__ Ey = &( *Ey2D )( i, 0 );
+        const double *__restrict__ Ey_im = &( *Ey2D )( i-1, 0 );
+        const double *__restrict__ Ez = &( *Ez2D )( i, 0 );
+        const double *__restrict__ Ez_im = &( *Ez2D )( i-1, 0 );
+        
         #pragma omp simd
         for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
-            ( *Bx2D )( i, j ) -= dt_ov_dy * ( ( *Ez2D )( i, j ) - ( *Ez2D )( i, j-1 ) );
+            Bx[j] -= dt_ov_dy * ( Ez[j] - Ez[j-1] );
         }
-        //    }
         
         // Magnetic field By^(d,p)
-        //    for (unsigned int i=1 ; i<nx_d-1 ; i++) {
         #pragma omp simd
         for( unsigned int j=0 ; j<ny_p ; j++ ) {
-            ( *By2D )( i, j ) += dt_ov_dx * ( ( *Ez2D )( i, j ) - ( *Ez2D )( i-1, j ) );
+            By[j] += dt_ov_dx * ( Ez[j] - Ez_im[j] );
         }
-        //}
         
         // Magnetic field Bz^(d,d)
-        //for (unsigned int i=1 ; i<nx_d-1 ; i++) {
         #pragma omp simd
         for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
-            ( *Bz2D )( i, j ) += dt_ov_dy * ( ( *Ex2D )( i, j ) - ( *Ex2D )( i, j-1 ) )
-                                 -               dt_ov_dx * ( ( *Ey2D )( i, j ) - ( *Ey2D )( i-1, j ) );
+            Bz[j] += dt_ov_dy * ( Ex[j] - Ex[j-1] )
+                     -               dt_ov_dx * ( Ey[j] - Ey_im[j] );
         }
     }
-    //}// end parallel
 }
-
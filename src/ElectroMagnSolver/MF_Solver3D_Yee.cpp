@@ -23,32 +23,55 @@ void MF_Solver3D_Yee::operator()( ElectroMagn *fields )
     Field3D *By3D = static_cast<Field3D *>( fields->By_ );
     Field3D *Bz3D = static_cast<Field3D *>( fields->Bz_ );
     
+    // The loops go through rows of the linearized arrays with restrict pointers,
+    // so that the inner loops are vectorized. The rows of large regions are shared among the threads
+    
+    const bool threaded = Tools::shareAmongThreads( nx_d*ny_d*nz_d );
+    
     // Magnetic field Bx^(p,d,d)
+    #pragma omp parallel for collapse(2) schedule(static) if( threaded )
     for( unsigned int i=0 ; i<nx_p;  i++ ) {
         for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
+            double *__restrict__ Bx = &( *Bx3D )( i, j, 0 );
+            const double *__restrict__ Ey = &( *Ey3D )( i, j, 0 );
+            const double *__restrict__ Ez = &( *Ez3D )( i, j, 0 );
+            const double *__restrict__ Ez_jm = &( *Ez3D )( i, j-1, 0 );
+            #pragma omp simd
             for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
-                ( *Bx3D )( i, j, k ) += -dt_ov_dy * ( ( *Ez3D )( i, j, k ) - ( *Ez3D )( i, j-1, k ) ) + dt_ov_dz * ( ( *Ey3D )( i, j, k ) - ( *Ey3D )( i, j, k-1 ) );
+                Bx[k] += -dt_ov_dy * ( Ez[k] - Ez_jm[k] ) + dt_ov_dz * ( Ey[k] - Ey[k-1] );
             }
         }
     }
     
     // Magnetic field By^(d,p,d)
+    #pragma omp parallel for collapse(2) schedule(static) if( threaded )
     for( unsigned int i=1 ; i<nx_d-1 ; i++ ) {
         for( unsigned int j=0 ; j<ny_p ; j++ ) {
+            double *__restrict__ By = &( *By3D )( i, j, 0 );
+            const double *__restrict__ Ex = &( *Ex3D )( i, j, 0 );
+            const double *__restrict__ Ez = &( *Ez3D )( i, j, 0 );
+            const double *__restrict__ Ez_im = &( *Ez3D )( i-1, j, 0 );
+            #pragma omp simd
             for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
-                ( *By3D )( i, j, k ) += -dt_ov_dz * ( ( *Ex3D )( i, j, k ) - ( *Ex3D )( i, j, k-1 ) ) + dt_ov_dx * ( ( *Ez3D )( i, j, k ) - ( *Ez3D )( i-1, j, k ) );
+                By[k] += -dt_ov_dz * ( Ex[k] - Ex[k-1] ) + dt_ov_dx * ( Ez[k] - Ez_im[k] );
             }
         }
     }
     
     // Magnetic field Bz^(d,d,p)
+    #pragma omp parallel for collapse(2) schedule(static) if( threaded )
     for( unsigned int i=1 ; i<nx_d-1 ; i++ ) {
         for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
+            double *__restrict__ Bz = &( *Bz3D )( i, j, 0 );
+            const double *__restrict__ Ex = &( *Ex3D )( i, j, 0 );
+            const double *__restrict__ Ex_jm = &( *Ex3D )( i, j-1, 0 );
+            const double *__restrict__ Ey = &( *Ey3D )( i, j, 0 );
+            const double *__restrict__ Ey_im = &( *Ey3D )( i-1, j, 0 );
+            #pragma omp simd
             for( unsigned int k=0 ; k<nz_p ; k++ ) {
-                ( *Bz3D )( i, j, k ) += -dt_ov_dx * ( ( *Ey3D )( i, j, k ) - ( *Ey3D )( i-1, j, k ) ) + dt_ov_dy * ( ( *Ex3D )( i, j, k ) - ( *Ex3D )( i, j-1, k ) );
+                Bz[k] += -dt_ov_dx * ( Ey[k] - Ey_im[k] ) + dt_ov_dy * ( Ex[k] - Ex_jm[k] );
             }
         }
     }
     
 }
-
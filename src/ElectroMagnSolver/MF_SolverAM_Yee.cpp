@@ -22,6 +22,8 @@ MF_SolverAM_Yee::~MF_SolverAM_Yee()
 void MF_SolverAM_Yee::operator()( ElectroMagn *fields )
 {
 
+    const bool threaded = Tools::shareAmongThreads( nl_d*nr_d );
+    
     for( unsigned int imode=0 ; imode<Nmode ; imode++ ) {
     
         // Static-cast of the fields
@@ -38,6 +40,7 @@ void MF_SolverAM_Yee::operator()( ElectroMagn *fields )
         //double *invRd = ( static_cast<ElectroMagnAM *>( fields ) )->invRd;
         
         // Magnetic field Bl^(p,d)
+        #pragma omp parallel for schedule(static) if( threaded )
         for( unsigned int i=0 ; i<nl_p;  i++ ) {
             #pragma omp simd
             for( unsigned int j=1+isYmin*2 ; j<nr_d-1 ; j++ ) {
@@ -46,6 +49,7 @@ void MF_SolverAM_Yee::operator()( ElectroMagn *fields )
         }
         
         // Magnetic field Br^(d,p)
+        #pragma omp parallel for schedule(static) if( threaded )
         for( unsigned int i=1 ; i<nl_d-1 ; i++ ) {
             #pragma omp simd
             for( unsigned int j=isYmin*3 ; j<nr_p ; j++ ) { //Specific condition on axis
@@ -54,6 +58,7 @@ void MF_SolverAM_Yee::operator()( ElectroMagn *fields )
             }
         }
         // Magnetic field Bt^(d,d)
+        #pragma omp parallel for schedule(static) if( threaded )
         for( unsigned int i=1 ; i<nl_d-1 ; i++ ) {
             #pragma omp simd
             for( unsigned int j=1 + isYmin*2 ; j<nr_d-1 ; j++ ) {
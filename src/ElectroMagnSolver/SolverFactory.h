@@ -17,6 +17,8 @@
 #include "MF_Solver2D_Cowan.h"
 #include "MF_Solver2D_Lehe.h"
 #include "MF_Solver3D_Lehe.h"
+#include "MA_MF_Solver2D_Yee.h"
+#include "MA_MF_Solver3D_Yee.h"
 
 #include "PXR_Solver2D_GPSTD.h"
 #include "PXR_Solver3D_FDTD.h"
@@ -139,6 +141,29 @@ public:
         return solver;
     };
     
+    // Create the solver saving B and solving Maxwell-Ampere and Maxwell-Faraday in a single sweep
+    // Returns NULL when the combination of solvers has no such fused version,
+    // or with uncoupled grids, where the separate solvers share the large region among the threads
+    // -----------------------------
+    static Solver *createMAMF( Params &params )
+    {
+        Solver *solver = NULL;
+        
+        if( params.is_pxr || params.is_spectral || params.uncoupled_grids || params.pml_boundaries || params.maxwell_sol != "Yee" ) {
+            return solver;
+        }
+        
+        if( params.geometry == "2Dcartesian" ) {
+            if( ! params.Friedman_filter ) {
+                solver = new MA_MF_Solver2D_Yee( params );
+            }
+        } else if( params.geometry == "3Dcartesian" ) {
+            solver = new MA_MF_Solver3D_Yee( params );
+        }
+        
+        return solver;
+    };
+    
 };
 
 #endif
@@ -3,8 +3,10 @@
 
 #include <cmath>
 
+#include <algorithm>
 #include <vector>
 #include <cstdlib>
+#include <cstring>
 #include <string>
 #include <iostream>
 #include <fstream>
@@ -112,6 +114,24 @@ public:
     {
         return data_;
     }
+    
+    //! Allocate a linearized array of n values set to 0,
+    //! aligned on 64 bytes (cache line, widest SIMD registers)
+    static inline double *allocateData( unsigned int n )
+    {
+        void *p = NULL;
+        if( posix_memalign( &p, 64, std::max( n, 1u )*sizeof( double ) ) != 0 ) {
+            ERROR( "Cannot allocate a field of " << n << " values" );
+        }
+        memset( p, 0, n*sizeof( double ) );
+        return static_cast<double *>( p );
+    }
+    
+    //! Free an array allocated by allocateData
+    static inline void freeData( double *data )
+    {
+        free( data );
+    }
     //! reference access to the linearized array (with check in DEBUG mode)
     inline double &operator()( unsigned int i )
     {
@@ -58,7 +58,7 @@ Field1D::Field1D( string name_in, vector<unsigned int> dims ) : Field( dims, nam
 Field1D::~Field1D()
 {
     if( data_!=NULL ) {
-        delete [] data_;
+        freeData( data_ );
     }
 }
 
@@ -75,11 +75,7 @@ void Field1D::allocateDims()
     
     isDual_.resize( dims_.size(), 0 );
     
-    data_ = new double[ dims_[0] ];
-    //! \todo{change to memset (JD)}
-    for( unsigned int i=0; i<dims_[0]; i++ ) {
-        data_[i]=0.0;
-    }
+    data_ = allocateData( dims_[0] );
     
     globalDims_ = dims_[0];
     
@@ -87,7 +83,7 @@ void Field1D::allocateDims()
 
 void Field1D::deallocateDataAndSetTo( Field* f )
 {
-    delete [] data_;
+    freeData( data_ );
     data_=NULL;
 
     data_ = f->data_;
@@ -127,11 +123,7 @@ void Field1D::allocateDims( unsigned int mainDim, bool isPrimal )
         dims_[j] += isDual_[j];
     }
     
-    data_ = new double[ dims_[0] ];
-    //! \todo{change to memset (JD)}
-    for( unsigned int i=0; i<dims_[0]; i++ ) {
-        data_[i]=0.0;
-    }
+    data_ = allocateData( dims_[0] );
     
     globalDims_ = dims_[0];
     
@@ -65,8 +65,7 @@ Field2D::~Field2D()
 {
 
     if( data_!=NULL ) {
-        delete [] data_;
-        delete [] data_2D;
+        freeData( data_ );
     }
 }
 
@@ -81,21 +80,13 @@ void Field2D::allocateDims()
         ERROR( "Alloc error must be 2 : " << dims_.size() );
     }
     if( data_!=NULL ) {
-        delete [] data_;
+        freeData( data_ );
     }
     
     isDual_.resize( dims_.size(), 0 );
     
-    data_ = new double[dims_[0]*dims_[1]];
-    //! \todo{check row major order!!! (JD)}
-    
-    data_2D= new double*[dims_[0]];
-    for( unsigned int i=0; i<dims_[0]; i++ ) {
-        data_2D[i] = data_ + i*dims_[1];
-        for( unsigned int j=0; j<dims_[1]; j++ ) {
-            data_2D[i][j] = 0.0;
-        }
-    }
+    // Row-major linearized array, set to 0
+    data_ = allocateData( dims_[0]*dims_[1] );
     
     globalDims_ = dims_[0]*dims_[1];
     
@@ -103,13 +94,10 @@ void Field2D::allocateDims()
 
 void Field2D::deallocateDataAndSetTo( Field* f )
 {
-    delete [] data_;
+    freeData( data_ );
     data_ = NULL;
-    delete [] data_2D;
-    data_2D = NULL;
 
     data_   = f->data_;
-    data_2D = (static_cast<Field2D *>(f))->data_2D;
     
 }
 
@@ -131,7 +119,7 @@ void Field2D::allocateDims( unsigned int mainDim, bool isPrimal )
         ERROR( "Alloc error must be 2 : " << dims_.size() );
     }
     if( data_ ) {
-        delete [] data_;
+        freeData( data_ );
     }
     
     // isPrimal define if mainDim is Primal or Dual
@@ -148,16 +136,8 @@ void Field2D::allocateDims( unsigned int mainDim, bool isPrimal )
         dims_[j] += isDual_[j];
     }
     
-    data_ = new double[dims_[0]*dims_[1]];
-    //! \todo{check row major order!!! (JD)}
-    
-    data_2D= new double*[dims_[0]];
-    for( unsigned int i=0; i<dims_[0]; i++ )  {
-        data_2D[i] = data_ + i*dims_[1];
-        for( unsigned int j=0; j<dims_[1]; j++ ) {
-            data_2D[i][j] = 0.0;
-        }
-    }
+    // Row-major linearized array, set to 0
+    data_ = allocateData( dims_[0]*dims_[1] );
     
     globalDims_ = dims_[0]*dims_[1];
     
@@ -170,8 +150,8 @@ void Field2D::allocateDims( unsigned int mainDim, bool isPrimal )
 // ---------------------------------------------------------------------------------------------------------------------
 void Field2D::shift_x( unsigned int delta )
 {
-    memmove( &( data_2D[0][0] ), &( data_2D[delta][0] ), ( dims_[1]*dims_[0]-delta*dims_[1] )*sizeof( double ) );
-    memset( &( data_2D[dims_[0]-delta][0] ), 0, delta*dims_[1]*sizeof( double ) );
+    memmove( &( ( *this )( 0, 0 ) ), &( ( *this )( delta, 0 ) ), ( dims_[1]*dims_[0]-delta*dims_[1] )*sizeof( double ) );
+    memset( &( ( *this )( dims_[0]-delta, 0 ) ), 0, delta*dims_[1]*sizeof( double ) );
     
 }
 
@@ -188,7 +168,7 @@ double Field2D::norm2( unsigned int istart[3][2], unsigned int bufsize[3][2] )
     
     for( int i=idxlocalstart[0] ; i<idxlocalend[0] ; i++ ) {
         for( int j=idxlocalstart[1] ; j<idxlocalend[1] ; j++ ) {
-            nrj += data_2D[i][j]*data_2D[i][j];
+            nrj += ( *this )( i, j )*( *this )( i, j );
         }
     }
     
@@ -58,45 +58,27 @@ public:
     virtual void shift_x( unsigned int delta ) override;
     
     //! Overloading of the () operator allowing to set a new value for the (i,j) element of a Field2D
+    //! The data is stored in row-major order in the linearized array data_
     inline double &operator()( unsigned int i, unsigned int j )
     {
         DEBUGEXEC( if( i>=dims_[0] || j>=dims_[1] ) ERROR( name << "Out of limits ("<< i << "," << j << ")  > (" <<dims_[0] << "," <<dims_[1] << ")" ) );
-        DEBUGEXEC( if( !std::isfinite( data_2D[i][j] ) ) ERROR( name << " Not finite "<< i << "," << j << " = " << data_2D[i][j] ) );
-        return data_2D[i][j];
+        DEBUGEXEC( if( !std::isfinite( data_[i*dims_[1]+j] ) ) ERROR( name << " Not finite "<< i << "," << j << " = " << data_[i*dims_[1]+j] ) );
+        return data_[i*dims_[1]+j];
     };
     
-    /*inline double& operator () (unsigned int i) {
-        DEBUGEXEC(if (i>=dims_[0]*dims_[1]) ERROR("Out of limits & "<< i));
-        DEBUGEXEC(if (!std::isfinite(data_2D[i])) ERROR("Not finite "<< i));
-        return data_2D[i];
-    };*/
-    
     //! Overloading of the () operator allowing to get the value of the (i,j) element of a Field2D
     inline double operator()( unsigned int i, unsigned int j ) const
     {
         DEBUGEXEC( if( i>=dims_[0] || j>=dims_[1] ) ERROR( name << "Out of limits "<< i << " " << j ) );
-        DEBUGEXEC( if( !std::isfinite( data_2D[i][j] ) ) ERROR( name << "Not finite "<< i << "," << j << " = " << data_2D[i][j] ) );
-        return data_2D[i][j];
+        DEBUGEXEC( if( !std::isfinite( data_[i*dims_[1]+j] ) ) ERROR( name << "Not finite "<< i << "," << j << " = " << data_[i*dims_[1]+j] ) );
+        return data_[i*dims_[1]+j];
     };
     
-    /*inline double operator () (unsigned int i) const {
-        DEBUGEXEC(if (i>=dims_[0]*dims_[1]) ERROR("Out of limits & "<< i));
-        DEBUGEXEC(if (!std::isfinite(data_2D[i])) ERROR("Not finite "<< i));
-        return data_2D[i];
-    };*/
-    
-    //double** data_;
-    
     virtual double norm2( unsigned int istart[3][2], unsigned int bufsize[3][2] ) override;
     void put( Field *outField, Params &params, SmileiMPI *smpi, Patch *thisPatch, Patch *outPatch ) override;
     void add( Field *outField, Params &params, SmileiMPI *smpi, Patch *thisPatch, Patch *outPatch ) override;
     void get( Field  *inField, Params &params, SmileiMPI *smpi, Patch   *inPatch, Patch *thisPatch ) override;
     
-    //!\todo{Comment what are these stuffs (MG for JD)}
-    //double *data_2D;
-    //! this will present the data as a 2d matrix
-    double **data_2D;
-    
 };
 
 #endif
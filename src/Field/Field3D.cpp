@@ -66,11 +66,7 @@ Field3D::Field3D( string name_in, vector<unsigned int> dims ) : Field( dims, nam
 Field3D::~Field3D()
 {
     if( data_!=NULL ) {
-        delete [] data_;
-        for( unsigned int i=0; i<dims_[0]; i++ ) {
-            delete [] this->data_3D[i];
-        }
-        delete [] this->data_3D;
+        freeData( data_ );
     }
 }
 
@@ -84,23 +80,13 @@ void Field3D::allocateDims()
         ERROR( "Alloc error must be 3 : " << dims_.size() );
     }
     if( data_ ) {
-        delete [] data_;
+        freeData( data_ );
     }
     
     isDual_.resize( dims_.size(), 0 );
     
-    data_ = new double[dims_[0]*dims_[1]*dims_[2]];
-    //! \todo{check row major order!!!}
-    data_3D= new double **[dims_[0]];
-    for( unsigned int i=0; i<dims_[0]; i++ ) {
-        data_3D[i]= new double*[dims_[1]];
-        for( unsigned int j=0; j<dims_[1]; j++ ) {
-            data_3D[i][j] = data_ + i*dims_[1]*dims_[2] + j*dims_[2];
-            for( unsigned int k=0; k<dims_[2]; k++ ) {
-                this->data_3D[i][j][k] = 0.0;
-            }
-        }
-    }//i
+    // Row-major linearized array, set to 0
+    data_ = allocateData( dims_[0]*dims_[1]*dims_[2] );
     
     globalDims_ = dims_[0]*dims_[1]*dims_[2];
     
@@ -108,16 +94,10 @@ void Field3D::allocateDims()
 
 void Field3D::deallocateDataAndSetTo( Field* f )
 {
-    delete [] data_;
+    freeData( data_ );
     data_ = NULL;
-    for( unsigned int i=0; i<dims_[0]; i++ ) {
-        delete [] data_3D[i];
-    }
-    delete [] data_3D;
-    data_3D = NULL;
 
     data_   = f->data_;
-    data_3D = (static_cast<Field3D *>(f))->data_3D;
     
 }
 
@@ -141,7 +121,7 @@ void Field3D::allocateDims( unsigned int mainDim, bool isPrimal )
         ERROR( "Alloc error must be 3 : " << dims_.size() );
     }
     if( data_ ) {
-        delete [] data_;
+        freeData( data_ );
     }
     
     // isPrimal define if mainDim is Primal or Dual
@@ -158,18 +138,8 @@ void Field3D::allocateDims( unsigned int mainDim, bool isPrimal )
         dims_[j] += isDual_[j];
     }
     
-    data_ = new double[dims_[0]*dims_[1]*dims_[2]];
-    //! \todo{check row major order!!!}
-    data_3D= new double **[dims_[0]*dims_[1]];
-    for( unsigned int i=0; i<dims_[0]; i++ ) {
-        data_3D[i]= new double*[dims_[1]];
-        for( unsigned int j=0; j<dims_[1]; j++ ) {
-            this->data_3D[i][j] = data_ + i*dims_[1]*dims_[2] + j*dims_[2];
-            for( unsigned int k=0; k<dims_[2]; k++ ) {
-                this->data_3D[i][j][k] = 0.0;
-            }
-        }
-    }//i
+    // Row-major linearized array, set to 0
+    data_ = allocateData( dims_[0]*dims_[1]*dims_[2] );
     
     globalDims_ = dims_[0]*dims_[1]*dims_[2];
     
@@ -183,8 +153,8 @@ void Field3D::allocateDims( unsigned int mainDim, bool isPrimal )
 // ---------------------------------------------------------------------------------------------------------------------
 void Field3D::shift_x( unsigned int delta )
 {
-    memmove( &( data_3D[0][0][0] ), &( data_3D[delta][0][0] ), ( dims_[2]*dims_[1]*dims_[0]-delta*dims_[2]*dims_[1] )*sizeof( double ) );
-    memset( &( data_3D[dims_[0]-delta][0][0] ), 0, delta*dims_[1]*dims_[2]*sizeof( double ) );
+    memmove( &( ( *this )( 0, 0, 0 ) ), &( ( *this )( delta, 0, 0 ) ), ( dims_[2]*dims_[1]*dims_[0]-delta*dims_[2]*dims_[1] )*sizeof( double ) );
+    memset( &( ( *this )( dims_[0]-delta, 0, 0 ) ), 0, delta*dims_[1]*dims_[2]*sizeof( double ) );
     
 }
 
@@ -202,7 +172,7 @@ double Field3D::norm2( unsigned int istart[3][2], unsigned int bufsize[3][2] )
     for( int i=idxlocalstart[0] ; i<idxlocalend[0] ; i++ ) {
         for( int j=idxlocalstart[1] ; j<idxlocalend[1] ; j++ ) {
             for( int k=idxlocalstart[2] ; k<idxlocalend[2] ; k++ ) {
-                nrj += data_3D[i][j][k]*data_3D[i][j][k];
+                nrj += ( *this )( i, j, k )*( *this )( i, j, k );
             }
         }
     }
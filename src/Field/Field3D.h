@@ -59,32 +59,20 @@ public:
     virtual void shift_x( unsigned int delta ) override;
     
     //! Overloading of the () operator allowing to set a new value for the (i,j,k) element of a Field3D
+    //! The data is stored in row-major order in the linearized array data_
     inline double &operator()( unsigned int i, unsigned int j, unsigned int k )
     {
         DEBUGEXEC( if( i>=dims_[0] || j>=dims_[1] || k >= dims_[2] ) ERROR( name << "Out of limits & "<< i << " " << j << " " << k ) );
-        return data_3D[i][j][k];
+        return data_[( i*dims_[1]+j )*dims_[2]+k];
     };
     
-    /*inline double& operator () (unsigned int i)
-    {
-        DEBUGEXEC(if (i>=dims_[0]*dims_[1]*dims_[2]) ERROR("Out of limits & "<< i));
-        DEBUGEXEC(if (!std::isfinite(data_3D[i])) ERROR("Not finite "<< i));
-        return data_3D[i];
-    };*/
-    
     //! Overloading of the () operator allowing to get the value for the (i,j,k) element of a Field3D
     inline double operator()( unsigned int i, unsigned int j, unsigned int k ) const
     {
         DEBUGEXEC( if( i>=dims_[0] || j>=dims_[1] || k >= dims_[2] ) ERROR( name << "Out of limits "<< i << " " << j << " " << k ) );
-        return data_3D[i][j][k];
+        return data_[( i*dims_[1]+j )*dims_[2]+k];
     };
     
-    /*inline double operator () (unsigned int i) const {
-        DEBUGEXEC(if (i>=dims_[0]*dims_[1]*dims_[2]) ERROR("Out of limits & "<< i));
-        DEBUGEXEC(if (!std::isfinite(data_3D[i])) ERROR("Not finite "<< i));
-        return data_3D[i];
-    };*/
-    
     void extract_slice_yz( unsigned int ix, Field2D *field );
     void extract_slice_xz( unsigned int iy, Field2D *field );
     void extract_slice_xy( unsigned int iz, Field2D *field );
@@ -95,11 +83,6 @@ public:
     void add( Field *outField, Params &params, SmileiMPI *smpi, Patch *thisPatch, Patch *outPatch ) override;
     void get( Field  *inField, Params &params, SmileiMPI *smpi, Patch   *inPatch, Patch *thisPatch ) override;
     
-    //!\todo{Comment what are these stuffs (MG for JD)}
-    //double *data_3D;
-    //! this will present the data as a 3d matrix
-    double ***data_3D;
-    
 };
 
 #endif
@@ -52,7 +52,7 @@ void IonizationTunnel::operator()( Particles *particles, unsigned int ipart_min,
 {
 
     unsigned int Z, Zp1, newZ, k_times;
-    double TotalIonizPot, E, invE, factorJion, delta, ran_p, Mult, D_sum, P_sum, Pint_tunnel;
+    double TotalIonizPot, invE, factorJion, delta, ran_p, Mult, D_sum, P_sum, Pint_tunnel;
     vector<double> IonizRate_tunnel( atomic_number_ ), Dnom_tunnel( atomic_number_ );
     LocalFields Jion;
     double factorJion_0 = au_to_mec2 * EC_to_au*EC_to_au * invdt;
@@ -62,33 +62,80 @@ void IonizationTunnel::operator()( Particles *particles, unsigned int ipart_min,
     double *Ey = &( ( *Epart )[1*nparts] );
     double *Ez = &( ( *Epart )[2*nparts] );
     
-    for( unsigned int ipart=ipart_min ; ipart<ipart_max; ipart++ ) {
+    const int npart = ipart_max - ipart_min;
+    if( npart <= 0 ) {
+        return;
+    }
+    if( npart > ( int )invE_.size() ) {
+        invE_.resize( npart );
+        first_rate_.resize( npart );
+        random_numbers_.resize( npart );
+        ionizing_.resize( npart );
+    }
+    double *invE_buffer = invE_.data();
+    double *rate_buffer = first_rate_.data();
+    double *ran_buffer = random_numbers_.data();
+    int *ionizing = ionizing_.data();
+    short *charge = &( particles->charge( 0 ) );
     
-        // Current charge state of the ion
-        Z = ( unsigned int )( particles->charge( ipart ) );
-        
-        // If ion already fully ionized then skip
-        if( Z==atomic_number_ ) {
-            continue;
-        }
+    // One random number per particle, drawn in a single batch
+    patch->rand_->uniform( ran_buffer, npart );
+    
+    // First pass (vectorized): ionization rate of the current charge state, and probability
+    // that no ionization occurs. Only the particles which are ionized are flagged.
+    const int last_Z = atomic_number_-1;
+    const double *alpha = alpha_tunnel.data();
+    const double *beta  = beta_tunnel.data();
+    const double *gamma = gamma_tunnel.data();
+    #pragma omp simd
+    for( int i=0 ; i<npart; i++ ) {
+        int ipart = ipart_min + i;
+        int Zi = charge[ipart];
+        int Zc = std::min( Zi, last_Z );
         
         // Absolute value of the electric field normalized in atomic units
-        E = EC_to_au * sqrt( pow( *( Ex+ipart-ipart_ref ), 2 )
-                             +pow( *( Ey+ipart-ipart_ref ), 2 )
-                             +pow( *( Ez+ipart-ipart_ref ), 2 ) );
-        if( E<1e-10 ) {
-            continue;
+        double E = EC_to_au * sqrt( Ex[ipart-ipart_ref]*Ex[ipart-ipart_ref]
+                                    + Ey[ipart-ipart_ref]*Ey[ipart-ipart_ref]
+                                    + Ez[ipart-ipart_ref]*Ez[ipart-ipart_ref] );
+        // Fully ionized ions and vanishing fields are skipped
+        bool active = ( Zi < ( int )atomic_number_ ) && ( E >= 1e-10 );
+        
+        double inv = 1./std::max( E, 1e-10 );
+        double d = gamma[Zc]*inv;
+        double rate = beta[Zc] * exp( -d*one_third + alpha[Zc]*log( d ) );
+        double Pint = exp( -rate*dt );
+        
+        invE_buffer[i] = inv;
+        rate_buffer[i] = rate;
+        // Single ionization of the last electron, or start of the multiple ionization loop
+        ionizing[i] = active && ( ( Zc == last_Z ) ? ( ran_buffer[i] < 1.0 - Pint ) : ( Pint < ran_buffer[i] ) );
+    }
+    
+    // Compaction of the ionized particles, each of which creates one electron
+    ionized_.clear();
+    for( int i=0 ; i<npart; i++ ) {
+        if( ionizing[i] ) {
+            ionized_.push_back( i );
         }
+    }
+    if( ionized_.empty() ) {
+        return;
+    }
+    int idNew = new_electrons.size();
+    new_electrons.createParticles( ionized_.size() );
+    
+    // Second pass (scalar): Monte-Carlo routine of the ionized particles only
+    for( unsigned int iion=0 ; iion<ionized_.size(); iion++ ) {
+        int ibuf = ionized_[iion];
+        unsigned int ipart = ipart_min + ibuf;
         
-        // --------------------------------
-        // Start of the Monte-Carlo routine
-        // --------------------------------
+        // Current charge state of the ion
+        Z = ( unsigned int )( particles->charge( ipart ) );
         
-        invE = 1./E;
+        invE = invE_buffer[ibuf];
         factorJion = factorJion_0 * invE*invE;
-        delta      = gamma_tunnel[Z]*invE;
-        ran_p = patch->rand_->uniform();
-        IonizRate_tunnel[Z] = beta_tunnel[Z] * exp( -delta*one_third + alpha_tunnel[Z]*log( delta ) );
+        ran_p = ran_buffer[ibuf];
+        IonizRate_tunnel[Z] = rate_buffer[ibuf];
         
         // Total ionization potential (used to compute the ionization current)
         TotalIonizPot = 0.0;
@@ -99,11 +146,10 @@ void IonizationTunnel::operator()( Particles *particles, unsigned int ipart_min,
         
         if( Zp1 == atomic_number_ ) {
             // if ionization of the last electron: single ionization
+            // (the particle has been flagged because ran_p < 1-exp(-rate*dt))
             // -----------------------------------------------------
-            if( ran_p < 1.0 -exp( -IonizRate_tunnel[Z]*dt ) ) {
-                TotalIonizPot += Potential[Z];
-                k_times        = 1;
-            }
+            TotalIonizPot += Potential[Z];
+            k_times        = 1;
             
         } else {
             // else : multiple ionization can occur in one time-step
@@ -147,33 +193,28 @@ void IonizationTunnel::operator()( Particles *particles, unsigned int ipart_min,
         // Compute ionization current
         if (patch->EMfields->Jx_ != NULL){  // For the moment ionization current is not accounted for in AM geometry
             factorJion *= TotalIonizPot;
-            Jion.x = factorJion * *( Ex+ipart );
-            Jion.y = factorJion * *( Ey+ipart );
-            Jion.z = factorJion * *( Ez+ipart );
+            Jion.x = factorJion * *( Ex+ipart-ipart_ref );
+            Jion.y = factorJion * *( Ey+ipart-ipart_ref );
+            Jion.z = factorJion * *( Ez+ipart-ipart_ref );
             
             Proj->ionizationCurrents( patch->EMfields->Jx_, patch->EMfields->Jy_, patch->EMfields->Jz_, *particles, ipart, Jion );
         }
         
-        // Creation of the new electrons
+        // Creation of the new electron
         // (variable weights are used)
         // -----------------------------
-        if( k_times !=0 ) {
-            new_electrons.createParticle();
-            //new_electrons.initialize( new_electrons.size()+1, new_electrons.dimension() );
-            int idNew = new_electrons.size() - 1;
-            for( unsigned int i=0; i<new_electrons.dimension(); i++ ) {
-                new_electrons.position( i, idNew )=particles->position( i, ipart );
-            }
-            for( unsigned int i=0; i<3; i++ ) {
-                new_electrons.momentum( i, idNew ) = particles->momentum( i, ipart )*ionized_species_invmass;
-            }
-            new_electrons.weight( idNew )=double( k_times )*particles->weight( ipart );
-            new_electrons.charge( idNew )=-1;
-            
-            // Increase the charge of the particle
-            particles->charge( ipart ) += k_times;
+        for( unsigned int i=0; i<new_electrons.dimension(); i++ ) {
+            new_electrons.position( i, idNew )=particles->position( i, ipart );
+        }
+        for( unsigned int i=0; i<3; i++ ) {
+            new_electrons.momentum( i, idNew ) = particles->momentum( i, ipart )*ionized_species_invmass;
         }
+        new_electrons.weight( idNew )=double( k_times )*particles->weight( ipart );
+        new_electrons.charge( idNew )=-1;
+        idNew++;
         
+        // Increase the charge of the particle
+        particles->charge( ipart ) += k_times;
         
-    } // Loop on particles
+    } // Loop on ionized particles
 }
@@ -28,6 +28,18 @@ private:
     
     double one_third;
     std::vector<double> alpha_tunnel, beta_tunnel, gamma_tunnel;
+    
+    // ________________________________________
+    // Buffers of the vectorized pass, reused between calls
+    
+    //! Inverse field, first ionization rate and random number of the particles
+    std::vector<double> invE_;
+    std::vector<double> first_rate_;
+    std::vector<double> random_numbers_;
+    
+    //! Flags and indices of the particles which may be ionized during the time step
+    std::vector<int> ionizing_;
+    std::vector<int> ionized_;
 };
 
 
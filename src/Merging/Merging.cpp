@@ -32,3 +32,50 @@ Merging::Merging( Params &params, Species *species, Random * rand )
 Merging::~Merging()
 {
 }
+
+// -----------------------------------------------------------------------------
+//! Sort the particles by momentum cell with a counting sort.
+//! momentum_cell_index_ must contain the momentum cell of the
+//! number_of_particles particles starting at istart. On output,
+//! sorted_particles_ contains the particle indexes grouped by momentum cell,
+//! momentum_cell_particle_index_ the first index of each cell in
+//! sorted_particles_ and particles_per_momentum_cells_ their number.
+//! \param number_of_particles number of particles to sort
+//! \param momentum_cells      number of momentum cells
+//! \param istart              index of the first particle
+// -----------------------------------------------------------------------------
+void Merging::sortByMomentumCell( unsigned int number_of_particles,
+                                  unsigned int momentum_cells,
+                                  int istart )
+{
+    // assign does not reallocate when the capacity is sufficient
+    particles_per_momentum_cells_.assign( momentum_cells, 0 );
+    momentum_cell_particle_index_.assign( momentum_cells, 0 );
+    if( number_of_particles > sorted_particles_.size() ) {
+        sorted_particles_.resize( number_of_particles );
+    }
+    
+    unsigned int * count = particles_per_momentum_cells_.data();
+    unsigned int * first = momentum_cell_particle_index_.data();
+    unsigned int * cell  = momentum_cell_index_.data();
+    
+    // Number of particles per momentum cell
+    // No vectorization because of random memory accesses
+    for( unsigned int ipr=0 ; ipr<number_of_particles ; ipr++ ) {
+        count[cell[ipr]] += 1;
+    }
+    
+    // First index of each momentum cell in the sorted array
+    for( unsigned int ic = 1 ; ic < momentum_cells ; ic++ ) {
+        first[ic] = first[ic-1] + count[ic-1];
+        count[ic-1] = 0;
+    }
+    count[momentum_cells-1] = 0;
+    
+    // Particles placed in their momentum cell
+    for( unsigned int ipr=0 ; ipr<number_of_particles ; ipr++ ) {
+        unsigned int ic = cell[ipr];
+        sorted_particles_[first[ic] + count[ic]] = istart + ipr;
+        count[ic] += 1;
+    }
+}
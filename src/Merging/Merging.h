@@ -47,12 +47,34 @@ public:
 
 protected:
     
+    //! Sort the particles by momentum cell (counting sort)
+    //! from the momentum cell index of each particle (momentum_cell_index_)
+    //! \param number_of_particles number of particles to sort
+    //! \param momentum_cells      number of momentum cells
+    //! \param istart              index of the first particle
+    void sortByMomentumCell( unsigned int number_of_particles,
+                             unsigned int momentum_cells,
+                             int istart );
+    
     // Local rand generator
     Random * rand_;
     
     // Minimum number of particles per cell to process the merging
     unsigned int min_particles_per_cell_;
     
+    // Buffers reused between calls ____________________________
+    
+    // Momentum cell index of each particle
+    std::vector <unsigned int> momentum_cell_index_;
+    
+    // Particle indexes sorted by momentum cell
+    std::vector <unsigned int> sorted_particles_;
+    
+    // Number of particles and index of the first particle
+    // in sorted_particles_ for each momentum cell
+    std::vector <unsigned int> particles_per_momentum_cells_;
+    std::vector <unsigned int> momentum_cell_particle_index_;
+    
 private:
     
 };
@@ -154,17 +154,17 @@ void MergingVranicCartesian::operator() (
         // Cell keys shortcut
         // int *cell_keys = &( particles.cell_keys[0] );
 
-        // Local vector to store the momentum index in the momentum discretization
-        std::vector <unsigned int> momentum_cell_index(number_of_particles,0);
-//         unsigned int  * momentum_cell_index = (unsigned int*) aligned_alloc(64, number_of_particles*sizeof(unsigned int));
+        // The buffers are kept between calls to avoid an allocation per cell
+        if( number_of_particles > momentum_cell_index_.size() ) {
+            momentum_cell_index_.resize( number_of_particles );
+            gamma_.resize( number_of_particles );
+        }
 
-        // Sorted array of particle index
-        std::vector <unsigned int> sorted_particles(number_of_particles,0);
-//         unsigned int  * sorted_particles = (unsigned int*) aligned_alloc(64, number_of_particles*sizeof(unsigned int));
+        // Local vector to store the momentum index in the momentum discretization
+        unsigned int * momentum_cell_index = momentum_cell_index_.data();
 
         // Particle gamma factor
-        std::vector <double> gamma(number_of_particles,0);
-//         double  * gamma = (double*) aligned_alloc(64, number_of_particles*sizeof(double));
+        double * gamma = gamma_.data();
 
         // Computation of the particle gamma factor
         if (mass == 0) {
@@ -196,31 +196,37 @@ void MergingVranicCartesian::operator() (
         }
 
         // Computation of the maxima and minima for each direction
-        momentum_min[0] = momentum[0][istart];
-        momentum_max[0] = momentum[0][istart];
+        // (scalar reductions, vectorized with all compilers)
+        double mx_min = momentum[0][istart];
+        double mx_max = momentum[0][istart];
 
-        momentum_min[1] = momentum[1][istart];
-        momentum_max[1] = momentum[1][istart];
+        double my_min = momentum[1][istart];
+        double my_max = momentum[1][istart];
 
-        momentum_min[2] = momentum[2][istart];
-        momentum_max[2] = momentum[2][istart];
+        double mz_min = momentum[2][istart];
+        double mz_max = momentum[2][istart];
 
-#if __INTEL_COMPILER > 18000
         #pragma omp simd \
-        reduction(min:momentum_min)  \
-        reduction(max:momentum_max)
-#endif
+        reduction(min:mx_min) reduction(min:my_min) reduction(min:mz_min) \
+        reduction(max:mx_max) reduction(max:my_max) reduction(max:mz_max)
         for (ip=(unsigned int) (istart) ; ip < (unsigned int) (iend); ip++ ) {
-            momentum_min[0] = std::min(momentum_min[0],momentum[0][ip]);
-            momentum_max[0] = std::max(momentum_max[0],momentum[0][ip]);
+            mx_min = std::min(mx_min,momentum[0][ip]);
+            mx_max = std::max(mx_max,momentum[0][ip]);
 
-            momentum_min[1] = std::min(momentum_min[1],momentum[1][ip]);
-            momentum_max[1] = std::max(momentum_max[1],momentum[1][ip]);
+            my_min = std::min(my_min,momentum[1][ip]);
+            my_max = std::max(my_max,momentum[1][ip]);
 
-            momentum_min[2] = std::min(momentum_min[2],momentum[2][ip]);
-            momentum_max[2] = std::max(momentum_max[2],momentum[2][ip]);
+            mz_min = std::min(mz_min,momentum[2][ip]);
+            mz_max = std::max(mz_max,momentum[2][ip]);
         }
 
+        momentum_min[0] = mx_min;
+        momentum_max[0] = mx_max;
+        momentum_min[1] = my_min;
+        momentum_max[1] = my_max;
+        momentum_min[2] = mz_min;
+        momentum_max[2] = mz_max;
+
         // std::cerr << " momentum_min[0]: " << momentum_min[0]
         //           << " momentum_max[0]: " << momentum_max[0]
         //           << " momentum_min[1]: " << momentum_min[1]
@@ -355,21 +361,6 @@ void MergingVranicCartesian::operator() (
                                     * dim[1]
                                     * dim[2];
 
-        // Array containing the number of particles per momentum cells
-        std::vector <unsigned int> particles_per_momentum_cells(momentum_cells,0);
-//         unsigned int  * particles_per_momentum_cells = (unsigned int*) aligned_alloc(64, momentum_cells*sizeof(unsigned int));
-
-        // Array containing the first particle index of each momentum cell
-        // in the sorted particle array
-        std::vector <unsigned int> momentum_cell_particle_index(momentum_cells,0);
-//         unsigned int  * momentum_cell_particle_index = (unsigned int*) aligned_alloc(64, momentum_cells*sizeof(unsigned int));
-//
-//         // Initialization when using aligned_alloc
-//         for (ic = 0 ; ic < momentum_cells ; ic++) {
-//             momentum_cell_particle_index[ic] = 0;
-//             particles_per_momentum_cells[ic] = 0;
-//         }
-
         // std::cerr << "Cell index" << std::endl;
 
         // For each particle, momentum cell indexes are computed in the
@@ -406,45 +397,18 @@ void MergingVranicCartesian::operator() (
 
         }
 
-        // std::cerr << "number of particles per momentum cells" << std::endl;
-
-        // The number of particles per momentum cells
-        // is then determined.
-        // No vectorization because of random memory accesses
-        for (ipr=0; ipr<number_of_particles; ipr++ ) {
-            // Number of particles per momentum cells
-            particles_per_momentum_cells[momentum_cell_index[ipr]] += 1;
-        }
+        // Sort of the particles by momentum cell (counting sort)
+        sortByMomentumCell( number_of_particles, momentum_cells, istart );
 
-        // std::cerr << "Computation of the cell index" << std::endl;
-
-        // Computation of the cell index in the sorted array of particles
-        for (ic = 1 ; ic < momentum_cells ; ic++) {
-            momentum_cell_particle_index[ic]  = momentum_cell_particle_index[ic-1] + particles_per_momentum_cells[ic-1];
-            particles_per_momentum_cells[ic-1] = 0;
-        }
-        particles_per_momentum_cells[momentum_cells-1] = 0;
-
-        // std::cerr << "sort particles in correct bins" << std::endl;
-
-        // sort particles in correct bins according to their
-        // momentum properties
-        // Not vectorizable
-        for (ipr=0 ; ipr<number_of_particles; ipr++ ) {
-
-            // Momentum cell index for this particle
-            ic = momentum_cell_index[ipr];
-
-            // std::cerr << " ic: " << ic
-            //           << " ipr: " << ipr
-            //           << " momentum_cell_particle_index[ic]: " << momentum_cell_particle_index[ic]
-            //           << std::endl;
+        // Array containing the number of particles per momentum cells
+        unsigned int * particles_per_momentum_cells = particles_per_momentum_cells_.data();
 
-            sorted_particles[momentum_cell_particle_index[ic]
-            + particles_per_momentum_cells[ic]] = istart + ipr;
+        // Array containing the first particle index of each momentum cell
+        // in the sorted particle array
+        unsigned int * momentum_cell_particle_index = momentum_cell_particle_index_.data();
 
-            particles_per_momentum_cells[ic] += 1;
-        }
+        // Sorted array of particle index
+        unsigned int * sorted_particles = sorted_particles_.data();
 
 
         // For each momentum bin, merge packet of particles composed of
@@ -758,13 +722,6 @@ void MergingVranicCartesian::operator() (
                 }
             }
         }
-
-        // Free aligned arrays
-//         free(gamma);
-//         free(momentum_cell_index);
-//         free(sorted_particles);
-//         free(particles_per_momentum_cells);
-//         free(momentum_cell_particle_index);
     }
 
 }
@@ -80,6 +80,9 @@ protected:
 
 private:
 
+    // Particle gamma factor, buffer reused between calls
+    std::vector <double> gamma_;
+
 };
 
 #endif
@@ -171,23 +171,23 @@ void MergingVranicSpherical::operator() (
         // Cell keys shortcut
         // int *cell_keys = &( particles.cell_keys[0] );
 
+        // The buffers are kept between calls to avoid an allocation per cell
+        if( number_of_particles > momentum_cell_index_.size() ) {
+            momentum_cell_index_.resize( number_of_particles );
+            momentum_norm_.resize( number_of_particles );
+            particles_phi_.resize( number_of_particles );
+            particles_theta_.resize( number_of_particles );
+        }
+
         // Norm of the momentum
-        std::vector <double> momentum_norm(number_of_particles,0);
-//         double  * momentum_norm = (double*) aligned_alloc(64, number_of_particles*sizeof(double));
+        double * momentum_norm = momentum_norm_.data();
 
         // Local vector to store the momentum index in the momentum discretization
-        std::vector <unsigned int> momentum_cell_index(number_of_particles,0);
-//         unsigned int  * momentum_cell_index = (unsigned int*) aligned_alloc(64, number_of_particles*sizeof(unsigned int));
-
-        // Sorted array of particle index
-        std::vector <unsigned int> sorted_particles(number_of_particles,0);
-//         unsigned int  * sorted_particles = (unsigned int*) aligned_alloc(64, number_of_particles*sizeof(unsigned int));
+        unsigned int * momentum_cell_index = momentum_cell_index_.data();
 
         // Local vector to store the momentum angles in the spherical base
-        std::vector <double> particles_phi(number_of_particles,0);
-        std::vector <double> particles_theta(number_of_particles,0);
-//         double  * particles_phi = (double*) aligned_alloc(64, number_of_particles*sizeof(double));
-//         double  * particles_theta = (double*) aligned_alloc(64, number_of_particles*sizeof(double));
+        double * particles_phi = particles_phi_.data();
+        double * particles_theta = particles_theta_.data();
 
         // Computation of the particle momentum properties
         #pragma omp simd private(ipr)
@@ -364,7 +364,7 @@ void MergingVranicSpherical::operator() (
                     theta_dim[phi_i]   = std::max((unsigned int)(round(theta_interval / theta_delta[phi_i])), theta_dim_min);
                     if (accumulation_correction_) {
                         theta_delta[phi_i] = theta_interval / (theta_dim[phi_i]-1);
-                        theta_min[phi_i]   = theta_min_ref - 0.99*theta_delta[phi_i]*Rand::uniform();
+                        theta_min[phi_i]   = theta_min_ref - 0.99*theta_delta[phi_i]*rand_->uniform();
                         theta_max[phi_i]   = theta_delta[phi_i]*theta_dim[phi_i] + theta_min[phi_i];
                     } else {
                         theta_delta[phi_i] = theta_interval / (theta_dim[phi_i]);
@@ -377,7 +377,7 @@ void MergingVranicSpherical::operator() (
                     theta_dim[phi_i]   = theta_dim_min;
                     if (accumulation_correction_) {
                         theta_delta[phi_i] = theta_interval / (theta_dim[phi_i]-1);
-                        theta_min[phi_i]   = theta_min_ref - 0.99*theta_delta[phi_i]*Rand::uniform();
+                        theta_min[phi_i]   = theta_min_ref - 0.99*theta_delta[phi_i]*rand_->uniform();
                         theta_max[phi_i]   = theta_delta[phi_i]*theta_dim[phi_i] + theta_min[phi_i];
                     } else {
                         theta_delta[phi_i] = theta_interval / (theta_dim[phi_i]);
@@ -432,22 +432,6 @@ void MergingVranicSpherical::operator() (
             momentum_angular_cells += theta_dim[phi_i];
         }
 
-        // Array containing the number of particles per momentum cells
-        std::vector <unsigned int> particles_per_momentum_cells(momentum_cells,0);
-//         unsigned int  * particles_per_momentum_cells = (unsigned int*) aligned_alloc(64, momentum_cells*sizeof(unsigned int));
-
-        // Array containing the first particle index of each momentum cell
-        // in the sorted particle array
-        std::vector <unsigned int> momentum_cell_particle_index(momentum_cells,0);
-//         unsigned int  * momentum_cell_particle_index = (unsigned int*) aligned_alloc(64, momentum_cells*sizeof(unsigned int));
-//
-//         // Initialization when using aligned_alloc
-//         #pragma omp simd
-//         for (ic = 0 ; ic < momentum_cells ; ic++) {
-//             momentum_cell_particle_index[ic] = 0;
-//             particles_per_momentum_cells[ic] = 0;
-//         }
-
         // First Cell index in theta for each phi coordinates
         // (necessary since the theta_dim depends on phi)
         std::vector <unsigned int>  theta_start_index (phi_dim);
@@ -571,35 +555,18 @@ void MergingVranicSpherical::operator() (
             }
         }
 
-        // The number of particles per momentum cells
-        // is then determined.
-        // No vectorization because of random memory accesses
-        for (ipr=0; ipr<number_of_particles; ipr++ ) {
-            // Number of particles per momentum cells
-            particles_per_momentum_cells[momentum_cell_index[ipr]] += 1;
-        }
-
-        // Computation of the cell index in the sorted array of particles
-        // Noy vectorizable
-        for (ic = 1 ; ic < momentum_cells ; ic++) {
-            momentum_cell_particle_index[ic]  = momentum_cell_particle_index[ic-1] + particles_per_momentum_cells[ic-1];
-            particles_per_momentum_cells[ic-1] = 0;
-        }
-        particles_per_momentum_cells[momentum_cells-1] = 0;
+        // Sort of the particles by momentum cell (counting sort)
+        sortByMomentumCell( number_of_particles, momentum_cells, istart );
 
-        // sort particles in correct bins according to their
-        // momentum properties
-        // Not vectorizable
-        for (ipr=0 ; ipr<number_of_particles; ipr++ ) {
-
-            // Momentum cell index for this particle
-            ic = momentum_cell_index[ipr];
+        // Array containing the number of particles per momentum cells
+        unsigned int * particles_per_momentum_cells = particles_per_momentum_cells_.data();
 
-            sorted_particles[momentum_cell_particle_index[ic]
-            + particles_per_momentum_cells[ic]] = istart + ipr;
+        // Array containing the first particle index of each momentum cell
+        // in the sorted particle array
+        unsigned int * momentum_cell_particle_index = momentum_cell_particle_index_.data();
 
-            particles_per_momentum_cells[ic] += 1;
-        }
+        // Sorted array of particle index
+        unsigned int * sorted_particles = sorted_particles_.data();
 
         // Debugging
         /*for (mr_i=0 ; mr_i< mr_dim; mr_i++ ) {
@@ -988,24 +955,6 @@ void MergingVranicSpherical::operator() (
                 }
             }
         }
-
-        // Free aligned arrays
-//         free(momentum_norm);
-//         free(momentum_cell_index);
-//         free(cell_vec_x);
-//         free(cell_vec_y);
-//         free(cell_vec_z);
-//         free(particles_phi);
-//         free(particles_theta);
-//         free(sorted_particles);
-//         free(particles_per_momentum_cells);
-//         free(momentum_cell_particle_index);
-//         free(theta_start_index);
-//         free(theta_dim);
-//         free(theta_min);
-//         free(theta_max);
-//         free(theta_delta);
-//         free(inv_theta_delta);
     }
 
 }
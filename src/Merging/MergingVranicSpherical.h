@@ -80,6 +80,11 @@ protected:
 
 private:
 
+    // Buffers reused between calls: norm and angles of the particle momentum
+    std::vector <double> momentum_norm_;
+    std::vector <double> particles_phi_;
+    std::vector <double> particles_theta_;
+
 };
 
 #endif
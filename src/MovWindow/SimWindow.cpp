@@ -46,6 +46,7 @@ SimWindow::SimWindow( Params &params )
 #endif
     patch_to_be_created.resize( max_threads );
     patch_particle_created.resize( max_threads );
+    thread_safe_creation = false;
     
     if( PyTools::nComponents( "MovingWindow" ) ) {
         active = true;
@@ -136,6 +137,22 @@ void SimWindow::shift( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params,
 
             vecPatches_old.resize( nPatches );
             n_moved += params.n_space[0];
+            
+            // Particles of the new patches may be created by several threads unless a profile calls python
+            thread_safe_creation = true;
+            for( unsigned int ispec=0 ; ispec<nSpecies ; ispec++ ) {
+                Species *spec = vecPatches( 0 )->vecSpecies[ispec];
+                vector<Profile *> profiles = spec->velocity_profile_;
+                profiles.insert( profiles.end(), spec->temperature_profile_.begin(), spec->temperature_profile_.end() );
+                profiles.push_back( spec->charge_profile_ );
+                profiles.push_back( spec->density_profile_ );
+                profiles.push_back( spec->particles_per_cell_profile_ );
+                for( unsigned int iprof=0 ; iprof<profiles.size() ; iprof++ ) {
+                    if( profiles[iprof] && ! profiles[iprof]->isThreadSafe() ) {
+                        thread_safe_creation = false;
+                    }
+                }
+            }
         }
         //Cut off laser before exchanging any patches to avoid deadlock and store pointers in vecpatches_old.
 #ifndef _NO_MPI_TM
@@ -316,98 +333,53 @@ void SimWindow::shift( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params,
         #pragma omp barrier
 #endif
         
-        //Fill necessary patches with particles
+        //List the patches that need new particles
 #ifndef _NO_MPI_TM
-        #pragma omp master
+        #pragma omp single
 #endif
         {
+            patches_to_fill.clear();
             for( int ithread=0; ithread < max_threads ; ithread++ ) {
                 for( unsigned int j=0; j< ( patch_to_be_created[ithread] ).size(); j++ ) {
-                
-                    // Current newly created patch
-                    mypatch = vecPatches.patches_[patch_to_be_created[ithread][j]];
-                    
-                    // If new particles are required
                     if( patch_particle_created[ithread][j] ) {
-                        for( unsigned int ispec=0 ; ispec<nSpecies ; ispec++ ) {
-                            ParticleCreator particle_creator;
-                            particle_creator.associate(mypatch->vecSpecies[ispec]);
-                            particle_creator.create( params.n_space, params, mypatch, 0, 0 );
-                            
-                            // mypatch->vecSpecies[ispec]->ParticleCreator( params.n_space, params, mypatch, 0 );
-
-                            /*#ifdef _VECTO
-                                                    // Classical vectorized mode
-                                                    if (params.vectorization_mode == "on")
-                                                    {
-                                                        if ( dynamic_cast<SpeciesV*>(mypatch->vecSpecies[ispec]) )
-                                                            dynamic_cast<SpeciesV*>(mypatch->vecSpecies[ispec])->computeParticleCellKeys(params);
-                                                        mypatch->vecSpecies[ispec]->sortParticles(params);
-                                                    }
-                                                    // First adaptive vectorization mode
-                                                    else if (params.vectorization_mode == "adaptive_mixed_sort")
-                                                    {
-                                                        if ( dynamic_cast<SpeciesVAdaptiveMixedSort*>(mypatch->vecSpecies[ispec]) )
-                                                        {
-                                                            dynamic_cast<SpeciesVAdaptiveMixedSort*>(mypatch->vecSpecies[ispec])->configuration(params, mypatch);
-                                                        }
-                                                    }
-                                                    // Second adaptive vectorization mode
-                                                    else if (params.vectorization_mode == "adaptive")
-                                                    {
-                                                        if ( dynamic_cast<SpeciesVAdaptive*>(mypatch->vecSpecies[ispec]) )
-                                                            dynamic_cast<SpeciesVAdaptive*>(mypatch->vecSpecies[ispec])->computeParticleCellKeys(params);
-                                                        mypatch->vecSpecies[ispec]->sortParticles(params);
-                                                    }
-                                                }
-                            #endif
-                                                // We define the IDs of the new particles
-                                                for( unsigned int idiag=0; idiag<vecPatches.localDiags.size(); idiag++ )
-                                                    if( DiagnosticTrack* track = dynamic_cast<DiagnosticTrack*>(vecPatches.localDiags[idiag]) )
-                                                        track->setIDs( mypatch );
-                            #ifdef _VECTO
-                                            }
-                                            // Patches that have received particles from another patch
-                                            // without the creation of new particles
-                                            else // (patch_particle_created[ithread][j] == false)
-                                            {
-                                                for (unsigned int ispec=0 ; ispec<nSpecies ; ispec++)
-                                                {
-                                                    // For the adaptive vectorization, we partially reconfigure the patch
-                                                    // We do not have to sort, but operators may have to be reconfigured
-                                                    // First adaptive vectorization mode:
-                                                    if (params.vectorization_mode == "adaptive_mixed_sort") {
-                                                        if ( dynamic_cast<SpeciesVAdaptiveMixedSort*>(mypatch->vecSpecies[ispec]) )
-                                                        {
-                                                            dynamic_cast<SpeciesVAdaptiveMixedSort*>(mypatch->vecSpecies[ispec])->computeParticleCellKeys(params);
-                                                            dynamic_cast<SpeciesVAdaptiveMixedSort*>(mypatch->vecSpecies[ispec])->reconfigure_operators(params, mypatch);
-                                                        }
-                                                    }
-                                                    // Second adaptive vectorization mode:
-                                                    else if (params.vectorization_mode == "adaptive")
-                                                    {
-                                                        if ( dynamic_cast<SpeciesVAdaptive*>(mypatch->vecSpecies[ispec]) )
-                                                        {
-                                                            dynamic_cast<SpeciesVAdaptive*>(mypatch->vecSpecies[ispec])->computeParticleCellKeys(params);
-                                                        }
-                                                    }
-                            #endif*/
-                        }
-                        mypatch->copyPositions(mypatch->vecSpecies);
-                        if (params.geometry=="AMcylindrical") {
-                            for( unsigned int ispec=0 ; ispec<nSpecies ; ispec++ ) {
-                                ParticleCreator::regulateWeightwithPositionAM( mypatch->vecSpecies[ispec]->particles, mypatch->vecSpecies[ispec]->position_initialization_on_species_type_, mypatch->vecSpecies[ispec]->cell_length[1]);
-                            }
-                        }
-                        
-                        mypatch->EMfields->applyExternalFields( mypatch );
-                        if( params.save_magnectic_fields_for_SM ) {
-                            mypatch->EMfields->saveExternalFields( mypatch );
-                        }
-                        
-                    } // end test patch_particle_created[ithread][j]
-                } // end j loop
-            } // End ithread loop
+                        patches_to_fill.push_back( vecPatches.patches_[patch_to_be_created[ithread][j]] );
+                    }
+                }
+            }
+        }
+        
+        //Fill necessary patches with particles
+        //Each cell has its own random streams: the particles do not depend on the thread creating them
+        if( thread_safe_creation ) {
+#ifndef _NO_MPI_TM
+            #pragma omp for schedule(dynamic)
+#endif
+            for( unsigned int j=0; j< patches_to_fill.size(); j++ ) {
+                createParticles( patches_to_fill[j], params );
+            }
+        } else {
+#ifndef _NO_MPI_TM
+            #pragma omp master
+#endif
+            {
+                for( unsigned int j=0; j< patches_to_fill.size(); j++ ) {
+                    createParticles( patches_to_fill[j], params );
+                }
+            }
+        }
+        
+        //External fields may be python profiles
+#ifndef _NO_MPI_TM
+        #pragma omp master
+#endif
+        {
+            for( unsigned int j=0; j< patches_to_fill.size(); j++ ) {
+                mypatch = patches_to_fill[j];
+                mypatch->EMfields->applyExternalFields( mypatch );
+                if( params.save_magnectic_fields_for_SM ) {
+                    mypatch->EMfields->saveExternalFields( mypatch );
+                }
+            }
         } // End omp master region
 #ifndef _NO_MPI_TM
         #pragma omp barrier
@@ -626,6 +598,21 @@ void SimWindow::shift( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params,
 
 }
 
+void SimWindow::createParticles( Patch *patch, Params &params )
+{
+    for( unsigned int ispec=0 ; ispec<patch->vecSpecies.size() ; ispec++ ) {
+        ParticleCreator particle_creator;
+        particle_creator.associate( patch->vecSpecies[ispec] );
+        particle_creator.create( params.n_space, params, patch, 0, 0 );
+    }
+    patch->copyPositions( patch->vecSpecies );
+    if( params.geometry=="AMcylindrical" ) {
+        for( unsigned int ispec=0 ; ispec<patch->vecSpecies.size() ; ispec++ ) {
+            ParticleCreator::regulateWeightwithPositionAM( patch->vecSpecies[ispec]->particles, patch->vecSpecies[ispec]->position_initialization_on_species_type_, patch->vecSpecies[ispec]->cell_length[1] );
+        }
+    }
+}
+
 void SimWindow::operate(Region& region,  VectorPatch& vecPatches, SmileiMPI* smpi, Params& params, double time_dual)
 {
     region.patch_->exchangeField_movewin( region.patch_->EMfields->Ex_, params.n_space[0] );
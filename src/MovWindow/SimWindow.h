@@ -83,6 +83,9 @@ public:
     
     
 private:
+    //! Fill a new patch with the particles of all species
+    void createParticles( Patch *patch, Params &params );
+    
     //! Tells whether there is a moving window or not
     bool active;
     
@@ -104,6 +107,10 @@ private:
     std::vector< std::vector<unsigned int>> patch_to_be_created;
     //! Keep track of patches that receive particles
     std::vector< std::vector<bool>> patch_particle_created;
+    //! New patches to be filled with particles, shared among threads
+    std::vector<Patch *> patches_to_fill;
+    //! Whether the species profiles allow several threads to create particles at once
+    bool thread_safe_creation;
     //! Max number of threads
     int max_threads;
     //! Time of additional moving window shifts
@@ -296,7 +296,7 @@ void MultiphotonBreitWheeler::pair_emission( int ipart,
     int      nparticles;           // Total number of particles in the temporary arrays
     int      k, i;
     double   u[3];                 // propagation direction
-    double *chi = new double[2];   // temporary quantum parameters
+    double   chi[2];               // temporary quantum parameters
     double   inv_chiph_gammaph;    // (gamma_ph - 2) / chi
     double   p;
     // Commented particles displasment while particles injection not managed  in a better way
@@ -307,7 +307,7 @@ void MultiphotonBreitWheeler::pair_emission( int ipart,
     inv_chiph_gammaph = ( gammaph-2. )/particles.chi( ipart );
 
     // Get the pair quantum parameters to compute the energy
-    chi = MultiphotonBreitWheelerTables.computePairQuantumParameter( particles.chi( ipart ), rand_ );
+    MultiphotonBreitWheelerTables.computePairQuantumParameter( particles.chi( ipart ), chi, rand_ );
     
     // pair propagation direction // direction of the photon
     for( k = 0 ; k<3 ; k++ ) {
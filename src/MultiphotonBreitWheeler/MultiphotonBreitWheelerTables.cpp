@@ -83,6 +83,11 @@ void MultiphotonBreitWheelerTables::initialization( Params &params, SmileiMPI *s
             
         } else {
             MESSAGE(1,"Default tables (stored in the code) are used:");
+            
+            // A single copy of the tables is kept on each node
+            T_.table_.share( smpi );
+            xi_.min_particle_chi_.share( smpi );
+            xi_.table_.share( smpi );
         }
         
         MESSAGE( 1,"--- Table `integration_dt_dchi`:" );
@@ -93,6 +98,9 @@ void MultiphotonBreitWheelerTables::initialization( Params &params, SmileiMPI *s
                  << T_.min_photon_chi_ );
         MESSAGE( 2,"Maximum photon quantum parameter chi: "
                  << T_.max_photon_chi_ );
+        if( T_.polynomial_.exists() ) {
+            MESSAGE( 2,"Piecewise polynomial approximation: " << T_.polynomial_.size() << " bytes" );
+        }
                  
         MESSAGE( "" )
         
@@ -151,6 +159,10 @@ double MultiphotonBreitWheelerTables::computeBreitWheelerPairProductionRate( dou
     else if( ichiph >= T_.size_photon_chi_-1 ) {
         ichiph = T_.size_photon_chi_-2;
         dNBWdt = 2.067731275227008*pow( photon_chi, 5.0/3.0 );
+    }
+    // Piecewise polynomial version of the table
+    else if( T_.polynomial_.exists() ) {
+        dNBWdt = T_.polynomial_.evaluate( logchiph );
     } else {
         // Upper and lower values for linear interpolation
         logchiphm = ichiph*T_.photon_chi_delta_ + T_.log10_min_photon_chi_;
@@ -168,11 +180,11 @@ double MultiphotonBreitWheelerTables::computeBreitWheelerPairProductionRate( dou
 //! the multiphoton Breit-Wheeler pair creation
 //
 //! \param photon_chi photon quantum parameter
+//! \param chi        electron and positron quantum parameters (output)
 // -----------------------------------------------------------------------------
-double *MultiphotonBreitWheelerTables::computePairQuantumParameter( double photon_chi, Random * rand )
+void MultiphotonBreitWheelerTables::computePairQuantumParameter( double photon_chi, double * chi, Random * rand )
 {
     // Parameters
-    double *chi = new double[2];
     double logchiph;
     double log10_chipam, log10_chipap;
     double d;
@@ -262,8 +274,6 @@ double *MultiphotonBreitWheelerTables::computePairQuantumParameter( double photo
         // Positron quantum parameter
         chi[1] = photon_chi - chi[0];
     }
-
-    return chi;
 }
 
 // -----------------------------------------------------------------------------
@@ -310,6 +320,10 @@ void MultiphotonBreitWheelerTables::readTableT( SmileiMPI *smpi )
                          &T_.table_[0] );
 
                 H5Dclose( dataset_id );
+                
+                // Piecewise polynomial version of the table, if available
+                T_.polynomial_.read( fileId, "integration_dt_dchi_polynomial" );
+                
                 H5Fclose( fileId );
             }
             else {
@@ -325,6 +339,7 @@ void MultiphotonBreitWheelerTables::readTableT( SmileiMPI *smpi )
 
     // Bcast the table to all MPI ranks
     MultiphotonBreitWheelerTables::bcastTableT( smpi );
+    T_.polynomial_.bcast( smpi );
 
 }
 
@@ -441,9 +456,6 @@ void MultiphotonBreitWheelerTables::bcastTableT( SmileiMPI *smpi )
         buf_size = position;
         MPI_Pack_size( 2, MPI_DOUBLE, smpi->getGlobalComm(), &position );
         buf_size += position;
-        MPI_Pack_size( T_.size_photon_chi_, MPI_DOUBLE, smpi->getGlobalComm(),
-                       &position );
-        buf_size += position;
     }
 
     //MESSAGE( 2,"Buffer size: " << buf_size );
@@ -463,10 +475,6 @@ void MultiphotonBreitWheelerTables::bcastTableT( SmileiMPI *smpi )
                   1, MPI_DOUBLE, buffer, buf_size, &position, smpi->getGlobalComm() );
         MPI_Pack( &T_.max_photon_chi_,
                   1, MPI_DOUBLE, buffer, buf_size, &position, smpi->getGlobalComm() );
-
-        MPI_Pack( &T_.table_[0], T_.size_photon_chi_,
-                  MPI_DOUBLE, buffer, buf_size, &position, smpi->getGlobalComm() );
-
     }
 
     // Bcast all parameters
@@ -481,17 +489,13 @@ void MultiphotonBreitWheelerTables::bcastTableT( SmileiMPI *smpi )
                     &T_.min_photon_chi_, 1, MPI_DOUBLE, smpi->getGlobalComm() );
         MPI_Unpack( buffer, buf_size, &position,
                     &T_.max_photon_chi_, 1, MPI_DOUBLE, smpi->getGlobalComm() );
-
-        // Resize table before unpacking values
-        T_.table_.resize( T_.size_photon_chi_ );
-
-        MPI_Unpack( buffer, buf_size, &position, &T_.table_[0],
-                    T_.size_photon_chi_, MPI_DOUBLE, smpi->getGlobalComm() );
-
     }
 
     delete[] buffer;
 
+    // The table is stored once per node
+    T_.table_.bcast( smpi );
+
     T_.log10_min_photon_chi_ = log10( T_.min_photon_chi_ );
 
     // Computation of the delta
@@ -525,12 +529,6 @@ void MultiphotonBreitWheelerTables::bcastTableXi( SmileiMPI *smpi )
         buf_size = position;
         MPI_Pack_size( 2, MPI_DOUBLE, smpi->getGlobalComm(), &position );
         buf_size += position;
-        MPI_Pack_size( xi_.size_photon_chi_, MPI_DOUBLE, smpi->getGlobalComm(),
-                       &position );
-        buf_size += position;
-        MPI_Pack_size( xi_.size_photon_chi_*xi_.size_particle_chi_, MPI_DOUBLE,
-                       smpi->getGlobalComm(), &position );
-        buf_size += position;
     }
 
     //MESSAGE( 2,"Buffer size for MPI exchange: " << buf_size );
@@ -552,12 +550,6 @@ void MultiphotonBreitWheelerTables::bcastTableXi( SmileiMPI *smpi )
                   1, MPI_DOUBLE, buffer, buf_size, &position, smpi->getGlobalComm() );
         MPI_Pack( &xi_.max_photon_chi_,
                   1, MPI_DOUBLE, buffer, buf_size, &position, smpi->getGlobalComm() );
-
-        MPI_Pack( &xi_.min_particle_chi_[0], xi_.size_photon_chi_,
-                  MPI_DOUBLE, buffer, buf_size, &position, smpi->getGlobalComm() );
-
-        MPI_Pack( &xi_.table_[0], xi_.size_particle_chi_*xi_.size_photon_chi_,
-                  MPI_DOUBLE, buffer, buf_size, &position, smpi->getGlobalComm() );
     }
 
     // Bcast all parameters
@@ -574,20 +566,14 @@ void MultiphotonBreitWheelerTables::bcastTableXi( SmileiMPI *smpi )
                     &xi_.min_photon_chi_, 1, MPI_DOUBLE, smpi->getGlobalComm() );
         MPI_Unpack( buffer, buf_size, &position,
                     &xi_.max_photon_chi_, 1, MPI_DOUBLE, smpi->getGlobalComm() );
-
-        // Resize tables before unpacking values
-        xi_.min_particle_chi_.resize( xi_.size_photon_chi_ );
-        xi_.table_.resize( xi_.size_particle_chi_*xi_.size_photon_chi_ );
-
-        MPI_Unpack( buffer, buf_size, &position, &xi_.min_particle_chi_[0],
-                    xi_.size_photon_chi_, MPI_DOUBLE, smpi->getGlobalComm() );
-
-        MPI_Unpack( buffer, buf_size, &position, &xi_.table_[0],
-                    xi_.size_particle_chi_*xi_.size_photon_chi_, MPI_DOUBLE, smpi->getGlobalComm() );
     }
 
     delete[] buffer;
 
+    // The tables are stored once per node
+    xi_.min_particle_chi_.bcast( smpi );
+    xi_.table_.bcast( smpi );
+
     // Log10 of xi_.min_photon_chi_ for efficiency
     xi_.log10_min_photon_chi_ = log10( xi_.min_photon_chi_ );
 
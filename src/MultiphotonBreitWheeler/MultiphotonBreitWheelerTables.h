@@ -23,6 +23,8 @@
 #include "H5.h"
 #include "userFunctions.h"
 #include "Random.h"
+#include "PiecewisePolynomial.h"
+#include "SharedArray.h"
 
 //------------------------------------------------------------------------------
 //! MutliphotonBreitWheelerTables class: holds parameters, tables and
@@ -57,7 +59,8 @@ public:
     //! Computation of the electron and positron quantum parameters for
     //! the multiphoton Breit-Wheeler pair creation
     //! \param photon_chi photon quantum parameter
-    double *computePairQuantumParameter( double photon_chi, Random * rand );
+    //! \param chi        electron and positron quantum parameters (output)
+    void computePairQuantumParameter( double photon_chi, double * chi, Random * rand );
 
 
     // ---------------------------------------------------------------------
@@ -105,7 +108,7 @@ private:
     struct T {
         
         //! Array containing tabulated values of the function T
-        std::vector<double > table_;
+        SharedArray table_;
         
         //! Minimum boundary of the table T
         double min_photon_chi_;
@@ -125,6 +128,9 @@ private:
         //! Dimension of the array T
         int size_photon_chi_;
         
+        //! Piecewise polynomial approximation of the table, used instead of table_ when read from the file
+        PiecewisePolynomial polynomial_;
+        
     };
 
     struct T T_;
@@ -139,12 +145,12 @@ private:
         //! that gives gives the probability for a photon to decay into pair
         //! with an electron of energy in the range \f$[0, \chi_{e^-}]\f$
         //! This enables to compute the energy repartition between the electron and the positron
-        std::vector<double> table_;
+        SharedArray table_;
         
         //! Table containing the particle_chi min values
         //! Under this value, electron kinetic energy of the pair is
         //! considered negligible
-        std::vector<double > min_particle_chi_;
+        SharedArray min_particle_chi_;
         
         //! Minimum boundary for photon_chi in the table xi and xi_.chipamin
         double min_photon_chi_;
@@ -102,6 +102,9 @@ OpenPMDparams::OpenPMDparams( Params &p ):
             } else if( params->EM_BCs[i][j] == "zero" ) {
                 fieldBoundary          .addString( "open" );
                 fieldBoundaryParameters.addString( "zero" );
+            } else if( params->EM_BCs[i][j] == "PML" ) {
+                fieldBoundary          .addString( "open" );
+                fieldBoundaryParameters.addString( "PML" );
             } else {
                 ERROR( " impossible boundary condition " );
             }
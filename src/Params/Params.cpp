@@ -216,6 +216,14 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
         srand48( random_seed );
         // Init of the seed for the C++ random generator
         Rand::gen = std::mt19937( random_seed );
+    } else {
+        // The seed of the patch generators must be the same on all processes
+        int seed = 0;
+        if( smpi->isMaster() ) {
+            seed = Rand::device() & 0x7fffffff;
+        }
+        smpi->bcast( seed );
+        random_seed = seed;
     }
 
     // communication pattern initialized as partial B exchange
@@ -444,6 +452,10 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
     PyTools::extract( "solve_poisson", solve_poisson, "Main"   );
     PyTools::extract( "poisson_max_iteration", poisson_max_iteration, "Main"   );
     PyTools::extract( "poisson_max_error", poisson_max_error, "Main"   );
+    PyTools::extract( "poisson_preconditioner", poisson_preconditioner, "Main"   );
+    if( poisson_preconditioner != "multigrid" && poisson_preconditioner != "none" ) {
+        ERROR( "Main.poisson_preconditioner `" << poisson_preconditioner << "` should be `multigrid` or `none`" );
+    }
     // Relativistic Poisson Solver
     PyTools::extract( "solve_relativistic_poisson", solve_relativistic_poisson, "Main"   );
     PyTools::extract( "relativistic_poisson_max_iteration", relativistic_poisson_max_iteration, "Main"   );
@@ -519,6 +531,47 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
     }
 
 
+    // Absorbing layers (PML)
+    pml_boundaries = false;
+    for( unsigned int iDim = 0 ; iDim < nDim_field; iDim++ ) {
+        if( EM_BCs[iDim][0] == "PML" || EM_BCs[iDim][1] == "PML" ) {
+            pml_boundaries = true;
+        }
+    }
+    if( pml_boundaries ) {
+        if( geometry == "1Dcartesian" ) {
+            ERROR( "EM_boundary_conditions `PML` are not available in 1Dcartesian geometry" );
+        }
+        if( geometry == "AMcylindrical" && EM_BCs[1][1] == "PML" ) {
+            ERROR( "EM_boundary_conditions `PML` are only available along x in AMcylindrical geometry" );
+        }
+        if( is_spectral || is_pxr || maxwell_sol != "Yee" || Friedman_filter ) {
+            ERROR( "EM_boundary_conditions `PML` require the Yee solver without field filter" );
+        }
+        if( !PyTools::extractV( "number_of_pml_cells", number_of_pml_cells, "Main" ) ) {
+            ERROR( "The parameter `number_of_pml_cells` must be defined as a list of integers" );
+        }
+        if( number_of_pml_cells.size() == 1 ) {
+            number_of_pml_cells.resize( nDim_field, number_of_pml_cells[0] );
+        } else if( number_of_pml_cells.size() != nDim_field ) {
+            ERROR( "number_of_pml_cells must be the same size as the number of dimensions" );
+        }
+        PyTools::extract( "pml_reflection", pml_reflection, "Main" );
+        PyTools::extract( "pml_kappa_max", pml_kappa_max, "Main" );
+        PyTools::extract( "pml_alpha_max", pml_alpha_max, "Main" );
+        if( pml_reflection <= 0. || pml_reflection >= 1. ) {
+            ERROR( "pml_reflection must be between 0 and 1" );
+        }
+        if( pml_kappa_max < 1. || pml_alpha_max < 0. ) {
+            ERROR( "pml_kappa_max must be >= 1 and pml_alpha_max must be >= 0" );
+        }
+        for( unsigned int iDim = 0 ; iDim < nDim_field; iDim++ ) {
+            if( ( EM_BCs[iDim][0] == "PML" || EM_BCs[iDim][1] == "PML" ) && number_of_pml_cells[iDim] == 0 ) {
+                ERROR( "number_of_pml_cells must be > 0 along dimension "<<"012"[iDim] );
+            }
+        }
+    }
+
     // testing the CFL condition
     //!\todo (MG) CFL cond. depends on the Maxwell solv. ==> HERE JUST DONE FOR YEE!!!
     double res_space2=0;
@@ -963,6 +1016,11 @@ void Params::compute()
         }
         patch_dimensions[i] = n_space[i] * cell_length[i];
         n_cell_per_patch *= n_space[i];
+        // The PML must not reach the ghost cells of the neighbor patches, where it is not applied
+        if( pml_boundaries && ( EM_BCs[i][0] == "PML" || EM_BCs[i][1] == "PML" ) && number_of_pml_cells[i] + oversize[i] > n_space[i] ) {
+            ERROR( "ERROR in dimension " << i <<". number_of_pml_cells = " << number_of_pml_cells[i] << " must be <= "
+                   << n_space[i]-oversize[i] << " (patch length - number of ghost cells)" );
+        }
     } 
     //region_oversize = oversize ;
     if ( is_spectral && geometry == "AMcylindrical" )  {
@@ -1096,6 +1154,10 @@ void Params::print_init()
         MESSAGE( 1, "dimension " << i << " - (Spatial resolution, Grid length) : (" << res_space[i] << ", " << grid_length[i] << ")" );
         MESSAGE( 1, "            - (Number of cells,    Cell length)  : " << "(" << n_space_global[i] << ", " << cell_length[i] << ")" );
         MESSAGE( 1, "            - Electromagnetic boundary conditions: " << "(" << EM_BCs[i][0] << ", " << EM_BCs[i][1] << ")" );
+        if( EM_BCs[i][0] == "PML" || EM_BCs[i][1] == "PML" ) {
+            MESSAGE( 1, "            - PML: " << number_of_pml_cells[i] << " cells, reflection " << pml_reflection
+                     << ", kappa_max " << pml_kappa_max << ", alpha_max " << pml_alpha_max );
+        }
         if( open_boundaries ) {
             cout << setprecision( 2 );
             cout << "                     - Electromagnetic boundary conditions k    : " << "( [" << EM_BCs_k[2*i][0] ;
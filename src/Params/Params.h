@@ -153,6 +153,8 @@ public:
     unsigned int poisson_max_iteration;
     //! Maxium poisson error tolerated
     double poisson_max_error;
+    //! Preconditioner of the Poisson solvers ("multigrid" or "none")
+    std::string poisson_preconditioner;
 
     //"Relativistic" Poisson solver
     //! Do we solve "relativistic poisson problem" for relativistic species
@@ -238,6 +240,16 @@ public:
     unsigned int custom_region_oversize ;
     //! Number of damping cells
     std::vector<unsigned int> number_of_damping_cells;
+    
+    //! Are some EM boundary conditions absorbing layers (PML) ?
+    bool pml_boundaries;
+    //! Number of cells of the PML in each dimension
+    std::vector<unsigned int> number_of_pml_cells;
+    //! Theoretical reflection coefficient of the PML at normal incidence
+    double pml_reflection;
+    //! Maximum coordinate stretching and complex frequency shift in the PML
+    double pml_kappa_max;
+    double pml_alpha_max;
 
     unsigned int pseudo_spectral_guardells;
     bool apply_rotational_cleaning;
@@ -19,6 +19,7 @@
 #include "Species.h"
 #include "ParticleInjector.h"
 #include "Field3D.h"
+#include "Random.h"
 
 class ParticleCreator
 {
@@ -48,7 +49,8 @@ public:
                               Particles * particles,
                               Species * species,
                               unsigned int nPart,
-                              unsigned int iPart, double *indexes, Params &params );
+                              unsigned int iPart, double *indexes, Params &params,
+                              Random * rand );
     
     //! Creation of the particle momentum
     static void createMomentum( std::string momentum_initialization,
@@ -57,7 +59,8 @@ public:
                             unsigned int nPart,
                             unsigned int iPart,
                             double *temp,
-                            double *vel);
+                            double *vel,
+                            Random * rand );
     
     //! Creation of the particle weight
     static void createWeight( std::string position_initialization,
@@ -118,12 +121,18 @@ public:
     
 private:
 
-    //! Provides a Maxwell-Juttner distribution of energies
-    static std::vector<double> maxwellJuttner( Species * species, unsigned int npoints, double temperature );
-    //! Array used in the Maxwell-Juttner sampling (see doc)
-    static const double lnInvF[1000];
-    //! Array used in the Maxwell-Juttner sampling (see doc)
-    static const double lnInvH[1000];
+    //! Provides npoints kinetic energies (gamma-1) from a Maxwell-Juttner distribution (see doc)
+    static void maxwellJuttner( Species * species, unsigned int npoints, double temperature, Random * rand, double * energies );
+    //! Table of the inverse cumulative Maxwell-Juttner distributions, computed once and shared by all species
+    static const std::vector<double> &maxwellJuttnerTable();
+    //! Computes the table of the inverse cumulative Maxwell-Juttner distributions
+    static std::vector<double> tabulateMaxwellJuttner();
+    //! Number of points of the table in ln(-ln U), and of tabulated temperatures per decade
+    static const unsigned int mj_n_lnw = 1024, mj_per_decade = 32, mj_decades = 5;
+    //! Number of rows of the table: the classical limit, the tabulated temperatures and the ultra-relativistic limit
+    static const unsigned int mj_n_rows = mj_decades*mj_per_decade + 3;
+    //! Range of ln(-ln U) in the table, and lowest tabulated temperature
+    static const double mj_lnw_min, mj_lnw_max, mj_theta_min;
 };
 
 #endif
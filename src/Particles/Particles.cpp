@@ -2,6 +2,7 @@
 
 #include <cstring>
 #include <iostream>
+#include <algorithm>
 
 #include "Params.h"
 #include "Patch.h"
@@ -327,6 +328,58 @@ void Particles::copyParticles( unsigned int iPart, unsigned int nPart, Particles
 }
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Insert the particles of one property at the beginning of the bins: the bins are shifted from the last one,
+// so that each particle is moved once and the vector is resized at most once
+// ---------------------------------------------------------------------------------------------------------------------
+template <typename T>
+static void insertInBins( vector<T> &dest, const vector<T> &source, const vector<int> &source_index,
+                          const vector<int> &count, const vector<int> &first_index )
+{
+    int nbin = first_index.size();
+    int end = dest.size();
+    int shift = source_index.size();
+    dest.resize( end + shift );
+    for( int ibin = nbin-1 ; ibin >= 0 ; ibin-- ) {
+        // Existing particles of the bin (and the following ones for the last bin)
+        int begin = first_index[ibin];
+        copy_backward( dest.begin() + begin, dest.begin() + end, dest.begin() + end + shift );
+        // New particles at the beginning of the bin
+        shift -= count[ibin];
+        for( int i = 0 ; i < count[ibin] ; i++ ) {
+            dest[begin + shift + i] = source[source_index[shift + i]];
+        }
+        end = begin;
+    }
+}
+
+void Particles::insertParticlesInBins( Particles &source, const vector<int> &source_index, const vector<int> &count )
+{
+    if( source_index.empty() ) {
+        return;
+    }
+
+    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
+        insertInBins( *double_prop[iprop], *source.double_prop[iprop], source_index, count, first_index );
+    }
+
+    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
+        insertInBins( *short_prop[iprop], *source.short_prop[iprop], source_index, count, first_index );
+    }
+
+    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
+        insertInBins( *uint64_prop[iprop], *source.uint64_prop[iprop], source_index, count, first_index );
+    }
+
+    int shift = 0;
+    for( unsigned int ibin=0 ; ibin<first_index.size() ; ibin++ ) {
+        first_index[ibin] += shift;
+        shift += count[ibin];
+        last_index[ibin] += shift;
+    }
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Copy particle iPart at the end of dest_parts -- safe
 // ---------------------------------------------------------------------------------------------------------------------
@@ -82,6 +82,10 @@ public:
     //! Insert nPart particles starting at ipart to dest_id in dest_parts
     void copyParticles( unsigned int iPart, unsigned int nPart, Particles &dest_parts, int dest_id );
     
+    //! Insert the particles of source at the beginning of the bins, in a single pass
+    //! source_index lists the source particles sorted by bin, and count their number in each bin
+    void insertParticlesInBins( Particles &source, const std::vector<int> &source_index, const std::vector<int> &count );
+    
     //! Copy particle iPart at the end of dest_parts -- safe
     void copyParticleSafe( unsigned int ipart, Particles &dest_parts );
     
@@ -112,8 +112,8 @@ void Patch::initStep1( Params &params )
         oversize[iDim] = params.oversize[iDim];
     }
     
-    // Initialize the random number generator
-    rand_ = new Random( params.random_seed );
+    // Initialize the random number generator, keyed by the patch index
+    rand_ = new Random( params.random_seed, hindex );
     
     // Obtain the cell_volume
     cell_volume = params.cell_volume;
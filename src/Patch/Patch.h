@@ -30,6 +30,7 @@ class Patch
     friend class VectorPatch;
     friend class SimWindow;
     friend class SyncVectorPatch;
+    friend class PoissonPreconditioner;
     friend class AsyncMPIbuffers;
 public:
     //! Constructor for Patch
@@ -385,27 +386,33 @@ protected:
 };
 
 
+//! Append the decimal digits of a non-negative value to those of tag (12 and 34 give 1234)
+inline long long int appendDigits( long long int tag, int value )
+{
+    long long int shift( 10 );
+    while( shift <= value ) {
+        shift *= 10;
+    }
+    return tag*shift + value;
+}
+
 //! Return a unique id to identify all MPI communications
 //!  - 2 MPI process can have several communications in the same direction for the same operation
 //!  - the communication is identientified using :
 //!      - hilbert index of the sender + idir + ineighbor
+//! The digits are concatenated arithmetically: tags are rebuilt for every field of every patch
+//! each time the patches move, which made string streams a large part of the moving window cost
 inline int buildtag( int hindex, int send, int recv )
 {
-    std::stringstream stag( "" );
-    stag << hindex << send  << recv;
-    long long int tag( 0 );
-    stag >> tag;
-    return ( int )( tag );
+    long long int tag = appendDigits( appendDigits( std::abs( ( long long int )hindex ), send ), recv );
+    return ( int )( hindex < 0 ? -tag : tag );
 }
 
 inline int buildtag( int hindex, int send, int recv, int tagp )
 {
-    std::stringstream stag( "" );
-    //stag << hindex << send  << recv << tagp;
-    stag << hindex << send*2+ recv << tagp;
-    long long int tag( 0 );
-    stag >> tag;
-    return ( int )( tag );
+    //tag = hindex, send, recv, tagp;
+    long long int tag = appendDigits( appendDigits( std::abs( ( long long int )hindex ), send*2+ recv ), tagp );
+    return ( int )( hindex < 0 ? -tag : tag );
 }
 
 
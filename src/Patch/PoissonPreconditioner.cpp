@@ -0,0 +1,568 @@
+
+#include "PoissonPreconditioner.h"
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "VectorPatch.h"
+#include "SyncVectorPatch.h"
+#include "Params.h"
+#include "SmileiMPI.h"
+#include "Field1D.h"
+#include "Field2D.h"
+#include "Field3D.h"
+
+using namespace std;
+
+// Damping of the Jacobi smoother, and number of iterations on the coarsest level
+const double jacobi_damping = 0.8;
+const unsigned int n_coarsest_iterations = 20;
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Local multigrid: builds the levels, coarsening the strongest couplings first
+// ---------------------------------------------------------------------------------------------------------------------
+PoissonMultigrid::PoissonMultigrid( const unsigned int n[3], const double c[3] )
+{
+    unsigned int nl[3];
+    double cl[3];
+    for( unsigned int d=0; d<3; d++ ) {
+        n_[d] = n[d];
+        nl[d] = n[d];
+        cl[d] = c[d];
+    }
+
+    bool coarsen = true;
+    while( coarsen ) {
+        Level L;
+        unsigned int N[3];
+        for( unsigned int d=0; d<3; d++ ) {
+            L.n[d] = nl[d];
+            L.c[d] = cl[d];
+            N[d] = nl[d] + ( cl[d]>0. ? 2 : 0 );
+        }
+        L.stride[2] = 1;
+        L.stride[1] = N[2];
+        L.stride[0] = N[1]*N[2];
+        L.first = 0;
+        for( unsigned int d=0; d<3; d++ ) {
+            if( cl[d]>0. ) {
+                L.first += L.stride[d];
+            }
+        }
+        L.size = N[0]*N[1]*N[2];
+        L.diagonal = -2.*( cl[0]+cl[1]+cl[2] );
+        L.z.assign( L.size, 0. );
+        L.r.assign( L.size, 0. );
+        L.work.assign( L.size, 0. );
+
+        // Coarsen the directions with couplings close to the strongest one
+        double cmax = 0.;
+        for( unsigned int d=0; d<3; d++ ) {
+            if( nl[d] >= 3 ) {
+                cmax = max( cmax, cl[d] );
+            }
+        }
+        coarsen = false;
+        for( unsigned int d=0; d<3; d++ ) {
+            L.coarsened[d] = nl[d] >= 3 && cl[d] > 0. && cl[d] >= 0.5*cmax && nl[0]*nl[1]*nl[2] > 8;
+            coarsen = coarsen || L.coarsened[d];
+        }
+
+        // Prolongation: the fine point i is the coarse point (i-1)/2 if i is odd, or between i/2-1 and i/2 if i is even
+        for( unsigned int d=0; d<3; d++ ) {
+            for( unsigned int side=0; side<2; side++ ) {
+                L.prolongation_index[d][side].resize( nl[d] );
+                L.prolongation_weight[d][side].resize( nl[d] );
+            }
+            for( unsigned int i=0; i<nl[d]; i++ ) {
+                if( ! L.coarsened[d] || i%2 == 1 ) {
+                    L.prolongation_index[d][0][i] = L.coarsened[d] ? ( i-1 )/2 : i;
+                    L.prolongation_weight[d][0][i] = 1.;
+                    L.prolongation_index[d][1][i] = L.prolongation_index[d][0][i];
+                    L.prolongation_weight[d][1][i] = 0.;
+                } else {
+                    L.prolongation_index[d][0][i] = ( int )( i/2 ) - 1;
+                    L.prolongation_weight[d][0][i] = 0.5;
+                    L.prolongation_index[d][1][i] = i/2;
+                    L.prolongation_weight[d][1][i] = 0.5;
+                }
+            }
+        }
+        levels_.push_back( L );
+
+        for( unsigned int d=0; d<3; d++ ) {
+            if( L.coarsened[d] ) {
+                nl[d] /= 2;
+                cl[d] /= 4.;
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Local multigrid: z = V-cycle applied to r
+// ---------------------------------------------------------------------------------------------------------------------
+void PoissonMultigrid::solve( const double *r, double *z, const unsigned int stride[3] )
+{
+    Level &L = levels_[0];
+    for( unsigned int i=0; i<L.n[0]; i++ ) {
+        for( unsigned int j=0; j<L.n[1]; j++ ) {
+            const double *ri = &r[i*stride[0] + j*stride[1]];
+            double *Lr = &L.r[L.index( i, j, 0 )];
+            for( unsigned int k=0; k<L.n[2]; k++ ) {
+                Lr[k] = ri[k*stride[2]];
+            }
+        }
+    }
+
+    vcycle( 0 );
+
+    for( unsigned int i=0; i<L.n[0]; i++ ) {
+        for( unsigned int j=0; j<L.n[1]; j++ ) {
+            double *zi = &z[i*stride[0] + j*stride[1]];
+            const double *Lz = &L.z[L.index( i, j, 0 )];
+            for( unsigned int k=0; k<L.n[2]; k++ ) {
+                zi[k*stride[2]] = Lz[k];
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Local multigrid: damped Jacobi iteration
+// ---------------------------------------------------------------------------------------------------------------------
+void PoissonMultigrid::smooth( Level &L, bool from_zero )
+{
+    const double w = jacobi_damping / L.diagonal;
+    if( from_zero ) {
+        for( unsigned int i=0; i<L.n[0]; i++ ) {
+            for( unsigned int j=0; j<L.n[1]; j++ ) {
+                double *__restrict__ z = &L.z[L.index( i, j, 0 )];
+                const double *__restrict__ r = &L.r[L.index( i, j, 0 )];
+                #pragma omp simd
+                for( unsigned int k=0; k<L.n[2]; k++ ) {
+                    z[k] = w * r[k];
+                }
+            }
+        }
+        return;
+    }
+
+    // Neighbours along the unused directions are replaced by the point itself, with a null coupling
+    const int s0 = L.c[0]>0. ? L.stride[0] : 0;
+    const int s1 = L.c[1]>0. ? L.stride[1] : 0;
+    const int s2 = L.c[2]>0. ? 1 : 0;
+    const int nk = L.n[2];
+    const double c0 = L.c[0], c1 = L.c[1], c2 = L.c[2];
+    for( unsigned int i=0; i<L.n[0]; i++ ) {
+        for( unsigned int j=0; j<L.n[1]; j++ ) {
+            const unsigned int first = L.index( i, j, 0 );
+            const double *__restrict__ z = &L.z[first];
+            const double *__restrict__ r = &L.r[first];
+            double *__restrict__ znew = &L.work[first];
+            #pragma omp simd
+            for( int k=0; k<nk; k++ ) {
+                double neighbours = c0*( z[k+s0] + z[k-s0] ) + c1*( z[k+s1] + z[k-s1] ) + c2*( z[k+s2] + z[k-s2] );
+                znew[k] = ( 1.-jacobi_damping ) * z[k] + w * ( r[k] - neighbours );
+            }
+        }
+    }
+    L.z.swap( L.work );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Local multigrid: V-cycle from level l, with one pre- and one post-smoothing iteration
+// ---------------------------------------------------------------------------------------------------------------------
+void PoissonMultigrid::vcycle( unsigned int l )
+{
+    Level &L = levels_[l];
+
+    if( l == levels_.size()-1 ) {
+        smooth( L, true );
+        for( unsigned int it=1; it<n_coarsest_iterations; it++ ) {
+            smooth( L, false );
+        }
+        return;
+    }
+
+    smooth( L, true );
+
+    // Residual r - A z
+    const int s0 = L.c[0]>0. ? L.stride[0] : 0;
+    const int s1 = L.c[1]>0. ? L.stride[1] : 0;
+    const int s2 = L.c[2]>0. ? 1 : 0;
+    const int nk = L.n[2];
+    const double c0 = L.c[0], c1 = L.c[1], c2 = L.c[2], D = L.diagonal;
+    for( unsigned int i=0; i<L.n[0]; i++ ) {
+        for( unsigned int j=0; j<L.n[1]; j++ ) {
+            const unsigned int first = L.index( i, j, 0 );
+            const double *__restrict__ z = &L.z[first];
+            const double *__restrict__ r = &L.r[first];
+            double *__restrict__ res = &L.work[first];
+            #pragma omp simd
+            for( int k=0; k<nk; k++ ) {
+                res[k] = r[k] - D*z[k] - c0*( z[k+s0] + z[k-s0] ) - c1*( z[k+s1] + z[k-s1] ) - c2*( z[k+s2] + z[k-s2] );
+            }
+        }
+    }
+
+    // Restriction (full weighting): the coarse point I is the fine point 2I+1 along the coarsened directions
+    Level &C = levels_[l+1];
+    const double weight[3] = { 0.5, 1., 0.5 };
+    const int o0max = L.coarsened[0] ? 1 : 0;
+    const int o1max = L.coarsened[1] ? 1 : 0;
+    const double scale = ( L.coarsened[0] ? 0.5 : 1. ) * ( L.coarsened[1] ? 0.5 : 1. ) * ( L.coarsened[2] ? 0.5 : 1. );
+    const int nK = C.n[2];
+    for( unsigned int I=0; I<C.n[0]; I++ ) {
+        for( unsigned int J=0; J<C.n[1]; J++ ) {
+            double *__restrict__ Cr = &C.r[C.index( I, J, 0 )];
+            for( int K=0; K<nK; K++ ) {
+                Cr[K] = 0.;
+            }
+            for( int o0=-o0max; o0<=o0max; o0++ ) {
+                for( int o1=-o1max; o1<=o1max; o1++ ) {
+                    const double w = scale * weight[o0+1] * weight[o1+1];
+                    const unsigned int i = L.coarsened[0] ? 2*I+1+o0 : I;
+                    const unsigned int j = L.coarsened[1] ? 2*J+1+o1 : J;
+                    const double *__restrict__ res = &L.work[L.index( i, j, 0 )];
+                    if( L.coarsened[2] ) {
+                        #pragma omp simd
+                        for( int K=0; K<nK; K++ ) {
+                            Cr[K] += w * ( 0.5*res[2*K] + res[2*K+1] + 0.5*res[2*K+2] );
+                        }
+                    } else {
+                        #pragma omp simd
+                        for( int K=0; K<nK; K++ ) {
+                            Cr[K] += w * res[K];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    vcycle( l+1 );
+
+    // Prolongation (linear interpolation, null beyond the box)
+    const int C0 = C.first;
+    for( unsigned int i=0; i<L.n[0]; i++ ) {
+        for( unsigned int j=0; j<L.n[1]; j++ ) {
+            double *__restrict__ z = &L.z[L.index( i, j, 0 )];
+            for( unsigned int a=0; a<2; a++ ) {
+                for( unsigned int b=0; b<2; b++ ) {
+                    const double w = L.prolongation_weight[0][a][i] * L.prolongation_weight[1][b][j];
+                    if( w == 0. ) {
+                        continue;
+                    }
+                    const double *__restrict__ Cz = &C.z[C0 + L.prolongation_index[0][a][i]*( int )C.stride[0] + L.prolongation_index[1][b][j]*( int )C.stride[1]];
+                    if( L.coarsened[2] ) {
+                        const int *__restrict__ k0 = &L.prolongation_index[2][0][0];
+                        const int *__restrict__ k1 = &L.prolongation_index[2][1][0];
+                        const double *__restrict__ w0 = &L.prolongation_weight[2][0][0];
+                        const double *__restrict__ w1 = &L.prolongation_weight[2][1][0];
+                        #pragma omp simd
+                        for( int k=0; k<nk; k++ ) {
+                            z[k] += w * ( w0[k]*Cz[k0[k]] + w1[k]*Cz[k1[k]] );
+                        }
+                    } else {
+                        #pragma omp simd
+                        for( int k=0; k<nk; k++ ) {
+                            z[k] += w * Cz[k];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    smooth( L, false );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Strides of a field and index of the first real point of the patch. The directions of the simulation are mapped
+// to the last directions of the multigrid boxes, so that their innermost loops run along the contiguous direction
+// (stride[2] is always 1)
+// ---------------------------------------------------------------------------------------------------------------------
+unsigned int PoissonPreconditioner::firstRealPoint( Field *field, ElectroMagn *EM, unsigned int stride[3] )
+{
+    const unsigned int ndim = field->dims_.size();
+    unsigned int ifirst = 0;
+    unsigned int s = 1;
+    stride[0] = stride[1] = stride[2] = 0;
+    for( int d=ndim-1; d>=0; d-- ) {
+        stride[3-ndim+d] = s;
+        ifirst += EM->index_min_p_[d] * s;
+        s *= field->dims_[d];
+    }
+    return ifirst;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Two-level preconditioner: local multigrids and coarse operator (one unknown per patch)
+// ---------------------------------------------------------------------------------------------------------------------
+PoissonPreconditioner::PoissonPreconditioner( Params &params, VectorPatch &vecPatches, std::vector<double> c )
+{
+    const unsigned int ndim = c.size();
+    double coupling[3] = { 0., 0., 0. };
+    for( unsigned int d=0; d<ndim; d++ ) {
+        coupling[3-ndim+d] = c[d];
+    }
+
+    const unsigned int n_patches = params.tot_number_of_patches;
+    coarse_diagonal_.assign( n_patches, 0. );
+    coarse_coupling_.assign( 6*n_patches, 0. );
+    coarse_neighbor_.assign( 6*n_patches, 0 );
+    int dirichlet = 0;
+
+    for( unsigned int ipatch=0; ipatch<vecPatches.size(); ipatch++ ) {
+        Patch *patch = vecPatches( ipatch );
+        ElectroMagn *EM = patch->EMfields;
+
+        if( ndim == 1 ) {
+            z_.push_back( new Field1D( EM->r_->dims_ ) );
+        } else if( ndim == 2 ) {
+            z_.push_back( new Field2D( EM->r_->dims_ ) );
+        } else {
+            z_.push_back( new Field3D( EM->r_->dims_ ) );
+        }
+
+        // Real points of the patch, and the corresponding local multigrid
+        unsigned int n[3] = { 1, 1, 1 };
+        for( unsigned int d=0; d<ndim; d++ ) {
+            n[3-ndim+d] = EM->index_max_p_[d] - EM->index_min_p_[d] + 1;
+        }
+        unsigned int imultigrid = 0;
+        while( imultigrid < multigrids_.size()
+               && ( multigrids_[imultigrid]->n_[0] != n[0] || multigrids_[imultigrid]->n_[1] != n[1] || multigrids_[imultigrid]->n_[2] != n[2] ) ) {
+            imultigrid++;
+        }
+        if( imultigrid == multigrids_.size() ) {
+            multigrids_.push_back( new PoissonMultigrid( n, coupling ) );
+        }
+        patch_multigrid_.push_back( imultigrid );
+
+        // Row of the coarse operator: coupling through each face of the patch, with the neighbour patch
+        // or with the null potential at the boundary
+        unsigned int h = patch->Hindex();
+        for( unsigned int d=0; d<ndim; d++ ) {
+            double face_coupling = coupling[3-ndim+d];
+            for( unsigned int e=0; e<3; e++ ) {
+                if( e != 3-ndim+d ) {
+                    face_coupling *= n[e];
+                }
+            }
+            for( unsigned int side=0; side<2; side++ ) {
+                int neighbor = patch->neighbor_[d][side];
+                if( neighbor == ( int )h ) {
+                    continue;
+                }
+                coarse_diagonal_[h] -= face_coupling;
+                if( neighbor == MPI_PROC_NULL ) {
+                    dirichlet = 1;
+                } else {
+                    coarse_coupling_[6*h+2*d+side] = face_coupling;
+                    coarse_neighbor_[6*h+2*d+side] = neighbor + 1;
+                }
+            }
+        }
+    }
+
+    MPI_Allreduce( MPI_IN_PLACE, &coarse_diagonal_[0], n_patches, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+    MPI_Allreduce( MPI_IN_PLACE, &coarse_coupling_[0], 6*n_patches, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+    MPI_Allreduce( MPI_IN_PLACE, &coarse_neighbor_[0], 6*n_patches, MPI_INT, MPI_SUM, MPI_COMM_WORLD );
+    MPI_Allreduce( MPI_IN_PLACE, &dirichlet, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD );
+    for( unsigned int i=0; i<6*n_patches; i++ ) {
+        coarse_neighbor_[i] -= 1;
+    }
+    coarse_singular_ = ( dirichlet == 0 );
+
+    coarse_rhs_.resize( n_patches );
+    coarse_solution_.resize( n_patches );
+    coarse_r_.resize( n_patches );
+    coarse_p_.resize( n_patches );
+    coarse_Ap_.resize( n_patches );
+}
+
+PoissonPreconditioner::~PoissonPreconditioner()
+{
+    for( unsigned int ipatch=0; ipatch<z_.size(); ipatch++ ) {
+        delete z_[ipatch];
+    }
+    for( unsigned int i=0; i<multigrids_.size(); i++ ) {
+        delete multigrids_[i];
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// z = M r: V-cycle on each patch, plus the coarse correction constant on each patch
+// ---------------------------------------------------------------------------------------------------------------------
+void PoissonPreconditioner::apply( VectorPatch &vecPatches, SmileiMPI *smpi )
+{
+    std::fill( coarse_rhs_.begin(), coarse_rhs_.end(), 0. );
+
+    for( unsigned int ipatch=0; ipatch<vecPatches.size(); ipatch++ ) {
+        ElectroMagn *EM = vecPatches( ipatch )->EMfields;
+        Field *r = EM->r_;
+        Field *z = z_[ipatch];
+        unsigned int stride[3];
+        const unsigned int ifirst = firstRealPoint( r, EM, stride );
+
+        z->put_to( 0. );
+        multigrids_[patch_multigrid_[ipatch]]->solve( &( r->data_[ifirst] ), &( z->data_[ifirst] ), stride );
+
+        const unsigned int *n = multigrids_[patch_multigrid_[ipatch]]->n_;
+        double sum = 0.;
+        for( unsigned int i=0; i<n[0]; i++ ) {
+            for( unsigned int j=0; j<n[1]; j++ ) {
+                const double *ri = &( r->data_[ifirst + i*stride[0] + j*stride[1]] );
+                for( unsigned int k=0; k<n[2]; k++ ) {
+                    sum += ri[k];
+                }
+            }
+        }
+        coarse_rhs_[vecPatches( ipatch )->Hindex()] = sum;
+    }
+
+    MPI_Allreduce( MPI_IN_PLACE, &coarse_rhs_[0], coarse_rhs_.size(), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+    solveCoarse();
+
+    for( unsigned int ipatch=0; ipatch<vecPatches.size(); ipatch++ ) {
+        ElectroMagn *EM = vecPatches( ipatch )->EMfields;
+        Field *z = z_[ipatch];
+        unsigned int stride[3];
+        const unsigned int ifirst = firstRealPoint( z, EM, stride );
+        const unsigned int *n = multigrids_[patch_multigrid_[ipatch]]->n_;
+        const double e = coarse_solution_[vecPatches( ipatch )->Hindex()];
+        for( unsigned int i=0; i<n[0]; i++ ) {
+            for( unsigned int j=0; j<n[1]; j++ ) {
+                double *zi = &( z->data_[ifirst + i*stride[0] + j*stride[1]] );
+                for( unsigned int k=0; k<n[2]; k++ ) {
+                    zi[k] += e;
+                }
+            }
+        }
+    }
+
+    // z is null outside of the real points: summing the overlapping points of neighbour patches fills
+    // their ghost points, including the border point shared with the next patch
+    SyncVectorPatch::sumAlongAllDirectionsNoOMP( z_, vecPatches, smpi );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Scalar product r.z on the real points of a patch
+// ---------------------------------------------------------------------------------------------------------------------
+double PoissonPreconditioner::compute_rz( VectorPatch &vecPatches, unsigned int ipatch )
+{
+    ElectroMagn *EM = vecPatches( ipatch )->EMfields;
+    Field *r = EM->r_;
+    Field *z = z_[ipatch];
+    unsigned int stride[3];
+    const unsigned int ifirst = firstRealPoint( r, EM, stride );
+    const unsigned int *n = multigrids_[patch_multigrid_[ipatch]]->n_;
+    double r_dot_z = 0.;
+    for( unsigned int i=0; i<n[0]; i++ ) {
+        for( unsigned int j=0; j<n[1]; j++ ) {
+            const double *ri = &( r->data_[ifirst + i*stride[0] + j*stride[1]] );
+            const double *zi = &( z->data_[ifirst + i*stride[0] + j*stride[1]] );
+            for( unsigned int k=0; k<n[2]; k++ ) {
+                r_dot_z += ri[k] * zi[k];
+            }
+        }
+    }
+    return r_dot_z;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// New direction p = z + beta p
+// ---------------------------------------------------------------------------------------------------------------------
+void PoissonPreconditioner::update_p( VectorPatch &vecPatches, double beta )
+{
+    for( unsigned int ipatch=0; ipatch<vecPatches.size(); ipatch++ ) {
+        double *__restrict__ p = vecPatches( ipatch )->EMfields->p_->data_;
+        const double *__restrict__ z = z_[ipatch]->data_;
+        const unsigned int size = z_[ipatch]->globalDims_;
+        #pragma omp simd
+        for( unsigned int i=0; i<size; i++ ) {
+            p[i] = z[i] + beta * p[i];
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Coarse problem, solved identically by all processes
+// ---------------------------------------------------------------------------------------------------------------------
+void PoissonPreconditioner::solveCoarse()
+{
+    const unsigned int n = coarse_diagonal_.size();
+
+    // A single periodic patch has no coarse correction
+    if( n == 1 && coarse_singular_ ) {
+        coarse_solution_[0] = 0.;
+        return;
+    }
+
+    // Without boundary, the solution is defined up to a constant, and the right-hand side must have a null sum
+    if( coarse_singular_ ) {
+        double mean = 0.;
+        for( unsigned int i=0; i<n; i++ ) {
+            mean += coarse_rhs_[i];
+        }
+        mean /= n;
+        for( unsigned int i=0; i<n; i++ ) {
+            coarse_rhs_[i] -= mean;
+        }
+    }
+
+    double b_dot_b = 0.;
+    for( unsigned int i=0; i<n; i++ ) {
+        coarse_solution_[i] = 0.;
+        coarse_r_[i] = coarse_rhs_[i];
+        coarse_p_[i] = coarse_r_[i] / coarse_diagonal_[i];
+        b_dot_b += coarse_rhs_[i] * coarse_rhs_[i];
+    }
+    double r_dot_z = 0.;
+    for( unsigned int i=0; i<n; i++ ) {
+        r_dot_z += coarse_r_[i] * coarse_p_[i];
+    }
+
+    double r_dot_r = b_dot_b;
+    for( unsigned int iteration=0; iteration<10*n+100 && r_dot_r > 1.e-24*b_dot_b; iteration++ ) {
+        double p_dot_Ap = 0.;
+        for( unsigned int i=0; i<n; i++ ) {
+            double Ap = coarse_diagonal_[i] * coarse_p_[i];
+            for( unsigned int k=0; k<6; k++ ) {
+                if( coarse_neighbor_[6*i+k] >= 0 ) {
+                    Ap += coarse_coupling_[6*i+k] * coarse_p_[coarse_neighbor_[6*i+k]];
+                }
+            }
+            coarse_Ap_[i] = Ap;
+            p_dot_Ap += coarse_p_[i] * Ap;
+        }
+        double alpha = r_dot_z / p_dot_Ap;
+        double rnew_dot_z = 0.;
+        r_dot_r = 0.;
+        for( unsigned int i=0; i<n; i++ ) {
+            coarse_solution_[i] += alpha * coarse_p_[i];
+            coarse_r_[i] -= alpha * coarse_Ap_[i];
+            rnew_dot_z += coarse_r_[i] * coarse_r_[i] / coarse_diagonal_[i];
+            r_dot_r += coarse_r_[i] * coarse_r_[i];
+        }
+        double beta = rnew_dot_z / r_dot_z;
+        r_dot_z = rnew_dot_z;
+        for( unsigned int i=0; i<n; i++ ) {
+            coarse_p_[i] = coarse_r_[i] / coarse_diagonal_[i] + beta * coarse_p_[i];
+        }
+    }
+
+    if( coarse_singular_ ) {
+        double mean = 0.;
+        for( unsigned int i=0; i<n; i++ ) {
+            mean += coarse_solution_[i];
+        }
+        mean /= n;
+        for( unsigned int i=0; i<n; i++ ) {
+            coarse_solution_[i] -= mean;
+        }
+    }
+}
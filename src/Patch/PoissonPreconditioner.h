@@ -0,0 +1,115 @@
+
+#ifndef POISSONPRECONDITIONER_H
+#define POISSONPRECONDITIONER_H
+
+#include <vector>
+
+class VectorPatch;
+class Params;
+class SmileiMPI;
+class Field;
+class ElectroMagn;
+
+//! Geometric multigrid V-cycle for the operator sum_d c_d*( u(+1) + u(-1) - 2u ) on a box of points,
+//! with u=0 outside the box. Only the directions with the strongest couplings are coarsened at each
+//! level, so that the damped Jacobi smoother remains efficient for the anisotropic operator of the
+//! relativistic Poisson problem. The cycle is symmetric, so that it can precondition a conjugate gradient.
+class PoissonMultigrid
+{
+public:
+    //! n: number of points along each direction (1 for unused directions), c: couplings along each direction
+    PoissonMultigrid( const unsigned int n[3], const double c[3] );
+
+    //! z = approximate solution of A z = r
+    //! r and z point to the first point of the box in arrays of strides `stride`
+    void solve( const double *r, double *z, const unsigned int stride[3] );
+
+    //! Number of points of the box along each direction
+    unsigned int n_[3];
+
+private:
+    struct Level {
+        //! Number of points along each direction
+        unsigned int n[3];
+        //! Memory strides, index of the first point and total size (a null point is added on each side of the
+        //! used directions, so that the stencil needs no test)
+        unsigned int stride[3], first, size;
+        //! Couplings along each direction (0 for unused directions), and diagonal of the operator
+        double c[3], diagonal;
+        //! Directions coarsened to get the next level
+        bool coarsened[3];
+        //! Points of the next level (and their weights) interpolated on each point, along each direction
+        std::vector<int> prolongation_index[3][2];
+        std::vector<double> prolongation_weight[3][2];
+        //! Solution, right-hand side and work array
+        std::vector<double> z, r, work;
+        //! Index of the point (i,j,k) of the box
+        inline unsigned int index( unsigned int i, unsigned int j, unsigned int k ) const
+        {
+            return first + i*stride[0] + j*stride[1] + k*stride[2];
+        };
+    };
+
+    //! V-cycle starting from level l, with a null initial guess
+    void vcycle( unsigned int l );
+    //! Damped Jacobi iteration on level l (the first one from a null initial guess if `from_zero`)
+    void smooth( Level &L, bool from_zero );
+
+    std::vector<Level> levels_;
+};
+
+//! Two-level preconditioner for the conjugate gradient of the Poisson problems, reusing the patch decomposition.
+//! M = sum_patches V_patch + R0^T A0^-1 R0 where V_patch is a multigrid V-cycle on the real points of each patch
+//! (the other points being null) and A0 is the Galerkin projection of the operator on the functions constant on
+//! each patch. A0 has one unknown per patch: it is gathered on all processes and solved redundantly, which makes
+//! the number of iterations nearly independent of the number of patches.
+class PoissonPreconditioner
+{
+public:
+    //! c: couplings of the Poisson operator along each direction ( 1/dx^2, divided by gamma^2 along x for the
+    //! relativistic Poisson problem ). Must be built after initPoisson.
+    PoissonPreconditioner( Params &params, VectorPatch &vecPatches, std::vector<double> c );
+    ~PoissonPreconditioner();
+
+    //! z = M r on all patches, including their ghost points
+    void apply( VectorPatch &vecPatches, SmileiMPI *smpi );
+
+    //! Scalar product of the residual r with z, on the real points of a patch
+    double compute_rz( VectorPatch &vecPatches, unsigned int ipatch );
+
+    //! New direction p = z + beta p on all patches
+    void update_p( VectorPatch &vecPatches, double beta );
+
+    //! Number of unknowns of the coarse problem (number of patches)
+    unsigned int coarseSize()
+    {
+        return coarse_diagonal_.size();
+    }
+
+private:
+    //! Index of the first real point of the patch in `field`, and strides along the directions of the multigrid boxes
+    static unsigned int firstRealPoint( Field *field, ElectroMagn *EM, unsigned int stride[3] );
+
+    //! Solves A0 coarse_solution_ = coarse_rhs_ by a Jacobi-preconditioned conjugate gradient
+    void solveCoarse();
+
+    //! Preconditioned residual, on each patch
+    std::vector<Field *> z_;
+
+    //! Local multigrid solvers (one per size of patch) and the one used by each patch
+    std::vector<PoissonMultigrid *> multigrids_;
+    std::vector<unsigned int> patch_multigrid_;
+
+    //! Coarse operator: diagonal, and coupling with the neighbour patches (hindex) in each direction
+    std::vector<double> coarse_diagonal_;
+    std::vector<double> coarse_coupling_;
+    std::vector<int> coarse_neighbor_;
+    //! True if no boundary fixes the potential (the constant potential is then removed)
+    bool coarse_singular_;
+    //! Coarse right-hand side (sum of the residual on each patch) and solution
+    std::vector<double> coarse_rhs_, coarse_solution_;
+    //! Work arrays of the coarse conjugate gradient
+    std::vector<double> coarse_r_, coarse_p_, coarse_Ap_;
+};
+
+#endif
@@ -996,6 +996,51 @@ void SyncVectorPatch::finalizeExchangeAlongAllDirectionsNoOMP( std::vector<Field
 }
 
 
+// Same as sum<double,Field>, for a single component, in a region executed by a single thread
+void SyncVectorPatch::sumAlongAllDirectionsNoOMP( std::vector<Field *> fields, VectorPatch &vecPatches, SmileiMPI *smpi )
+{
+    unsigned int dims[3] = { 1, 1, 1 }, gsp[3], h0, oversize[3], n_space[3];
+    h0 = vecPatches( 0 )->hindex;
+    for( unsigned int iDim=0 ; iDim<fields[0]->dims_.size() ; iDim++ ) {
+        dims[iDim] = fields[0]->dims_[iDim];
+    }
+    for( unsigned int iDim=0 ; iDim<3 ; iDim++ ) {
+        oversize[iDim] = vecPatches( 0 )->EMfields->oversize[iDim];
+        n_space[iDim] = vecPatches( 0 )->EMfields->n_space[iDim];
+    }
+    const unsigned int stride[3] = { dims[1]*dims[2], dims[2], 1 };
+
+    for( unsigned int iDim=0 ; iDim<fields[0]->dims_.size() ; iDim++ ) {
+        for( unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++ ) {
+            vecPatches( ipatch )->initSumField( fields[ipatch], iDim, smpi );
+        }
+
+        gsp[iDim] = 1+2*oversize[iDim]+fields[0]->isDual_[iDim]; //Ghost size primal
+        // Number of contiguous blocks of the overlapping region, and size of each block
+        const unsigned int nblocks = dims[0]*stride[0] / ( dims[iDim]*stride[iDim] );
+        const unsigned int block_size = gsp[iDim]*stride[iDim];
+        for( unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++ ) {
+            if( vecPatches( ipatch )->MPI_me_ == vecPatches( ipatch )->MPI_neighbor_[iDim][0] ) {
+                double *pt1 = &( *fields[vecPatches( ipatch )->neighbor_[iDim][0]-h0] )( n_space[iDim]*stride[iDim] );
+                double *pt2 = &( *fields[ipatch] )( 0 );
+                for( unsigned int iblock = 0 ; iblock < nblocks ; iblock++ ) {
+                    for( unsigned int i = 0 ; i < block_size ; i++ ) {
+                        pt1[i] += pt2[i];
+                        pt2[i] =  pt1[i];
+                    }
+                    pt1 += dims[iDim]*stride[iDim];
+                    pt2 += dims[iDim]*stride[iDim];
+                }
+            }
+        }
+
+        for( unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++ ) {
+            vecPatches( ipatch )->finalizeSumField( fields[ipatch], iDim );
+        }
+    }
+}
+
+
 //Proceed to the synchronization of field including corner ghost cells.
 //This is done by exchanging one dimension at a time
 template void SyncVectorPatch::exchangeSynchronizedPerDirection<double,Field>( std::vector<Field *> fields, VectorPatch &vecPatches, SmileiMPI *smpi );
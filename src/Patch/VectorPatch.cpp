@@ -22,6 +22,7 @@
 #include "Laser.h"
 
 #include "SyncVectorPatch.h"
+#include "PoissonPreconditioner.h"
 #include "interface.h"
 #include "Timers.h"
 
@@ -307,6 +308,18 @@ void VectorPatch::sortAllParticles( Params &params )
 #endif
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// For all patches, start the random number streams of the new time step
+// The random numbers then depend only on the seed, the patch and the iteration
+// ---------------------------------------------------------------------------------------------------------------------
+void VectorPatch::setRandomStreams( int itime )
+{
+    #pragma omp for schedule(static)
+    for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
+        patches_[ipatch]->rand_->setStream( itime );
+    }
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // For all patches, move particles (restartRhoJ(s), dynamics and exchangeParticles)
 // ---------------------------------------------------------------------------------------------------------------------
@@ -336,6 +349,8 @@ void VectorPatch::dynamics( Params &params,
             if( spec->ponderomotive_dynamics ) {
                 continue;
             }
+            // Each species draws from its own stream (ionization, radiation, pair creation)
+            ( *this )( ipatch )->rand_->setStream( itime, ispec+1 );
             if( spec->isProj( time_dual, simWindow ) || diag_flag ) {
                 // Dynamics with vectorized operators
                 if( spec->vectorized_operators || params.cell_sorting ) {
@@ -499,8 +514,12 @@ void VectorPatch::mergeParticles(Params &params, SmileiMPI *smpi, double time_du
             if (species( ipatch, ispec )->has_merging_) {
 
                 // Check the time selection
-                if( species( ipatch, ispec )->merging_time_selection_->theTimeIsNow( itime ) ) {
-                    species( ipatch, ispec )->mergeParticles( time_dual, ispec,
+                // (every iteration in its range when the merging is amortized)
+                TimeSelection * merging_time_selection = species( ipatch, ispec )->merging_time_selection_;
+                if( species( ipatch, ispec )->merge_amortized_ ?
+                    merging_time_selection->inProgress( itime ) :
+                    merging_time_selection->theTimeIsNow( itime ) ) {
+                    species( ipatch, ispec )->mergeParticles( time_dual, itime, ispec,
                             params,
                             ( *this )( ipatch ), smpi,
                             localDiags );
@@ -1054,22 +1073,36 @@ void VectorPatch::solveMaxwell( Params &params, SimWindow *simWindow, int itime,
         (*this)( 0 )->EMfields->MaxwellAmpereSolver_->densities_correction( (*this)( 0 )->EMfields );
     }
 
-    #pragma omp for schedule(static)
-    for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-        if( !params.is_spectral ) {
-            // Saving magnetic fields (to compute centered fields used in the particle pusher)
-            // Stores B at time n in B_m.
-            ( *this )( ipatch )->EMfields->saveMagneticFields( params.is_spectral );
+    if( ( *this )( 0 )->EMfields->MaxwellSolver_ ) {
+        // Same as below, in a single sweep of each patch
+        #pragma omp for schedule(static)
+        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            ( *( *this )( ipatch )->EMfields->MaxwellSolver_ )( ( *this )( ipatch )->EMfields );
+        }
+    } else {
+        #pragma omp for schedule(static)
+        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            if( !params.is_spectral ) {
+                // Saving magnetic fields (to compute centered fields used in the particle pusher)
+                // Stores B at time n in B_m.
+                ( *this )( ipatch )->EMfields->saveMagneticFields( params.is_spectral );
+            }
+            // Computes Ex_, Ey_, Ez_ on all points.
+            // E is already synchronized because J has been synchronized before.
+            ( *( *this )( ipatch )->EMfields->MaxwellAmpereSolver_ )( ( *this )( ipatch )->EMfields );
+            if( params.pml_boundaries ) {
+                ( *this )( ipatch )->EMfields->correctPML( true, time_dual, ( *this )( ipatch ), simWindow );
+            }
         }
-        // Computes Ex_, Ey_, Ez_ on all points.
-        // E is already synchronized because J has been synchronized before.
-        ( *( *this )( ipatch )->EMfields->MaxwellAmpereSolver_ )( ( *this )( ipatch )->EMfields );
-    }
 
-    #pragma omp for schedule(static)
-    for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-        // Computes Bx_, By_, Bz_ at time n+1 on interior points.
-        ( *( *this )( ipatch )->EMfields->MaxwellFaradaySolver_ )( ( *this )( ipatch )->EMfields );
+        #pragma omp for schedule(static)
+        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            // Computes Bx_, By_, Bz_ at time n+1 on interior points.
+            ( *( *this )( ipatch )->EMfields->MaxwellFaradaySolver_ )( ( *this )( ipatch )->EMfields );
+            if( params.pml_boundaries ) {
+                ( *this )( ipatch )->EMfields->correctPML( false, time_dual, ( *this )( ipatch ), simWindow );
+            }
+        }
     }
     //Synchronize B fields between patches.
     timers.maxwell.update( params.printNow( itime ) );
@@ -1404,6 +1437,24 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI *smpi )
     // compute control parameter
     double ctrl = rnew_dot_rnew / ( double )( nx_p2_global );
 
+    // Multigrid preconditioner: the first direction is the preconditioned residual z = M r
+    PoissonPreconditioner *preconditioner = NULL;
+    double r_dot_z = 0.;
+    if( params.poisson_preconditioner == "multigrid" ) {
+        std::vector<double> coupling( params.nDim_field );
+        for( unsigned int d=0 ; d<params.nDim_field ; d++ ) {
+            coupling[d] = 1./( params.cell_length[d]*params.cell_length[d] );
+        }
+        preconditioner = new PoissonPreconditioner( params, *this, coupling );
+        preconditioner->apply( *this, smpi );
+        preconditioner->update_p( *this, 0. );
+        double r_dot_z_local = 0.;
+        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            r_dot_z_local += preconditioner->compute_rz( *this, ipatch );
+        }
+        MPI_Allreduce( &r_dot_z_local, &r_dot_z, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+    }
+
     // ---------------------------------------------------------
     // Starting iterative loop for the conjugate gradient method
     // ---------------------------------------------------------
@@ -1438,23 +1489,40 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI *smpi )
 
         // compute new potential and residual
         for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            ( *this )( ipatch )->EMfields->update_pand_r( r_dot_r, p_dot_Ap );
+            ( *this )( ipatch )->EMfields->update_pand_r( preconditioner ? r_dot_z : r_dot_r, p_dot_Ap );
         }
 
-        // compute new residual norm
-        rnew_dot_rnew       = 0.0;
-        rnew_dot_rnew_local = 0.0;
+        // compute new residual norm (and its product with the previous preconditioned residual)
+        double dot_local[2] = { 0., 0. };
+        double dot[2];
         for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            rnew_dot_rnew_local += ( *this )( ipatch )->EMfields->compute_r();
+            dot_local[0] += ( *this )( ipatch )->EMfields->compute_r();
+            if( preconditioner ) {
+                dot_local[1] += preconditioner->compute_rz( *this, ipatch );
+            }
         }
-        MPI_Allreduce( &rnew_dot_rnew_local, &rnew_dot_rnew, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+        MPI_Allreduce( dot_local, dot, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+        rnew_dot_rnew = dot[0];
         if( smpi->isMaster() ) {
             DEBUG( "new residual norm: rnew_dot_rnew = " << rnew_dot_rnew );
         }
 
         // compute new directio
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            ( *this )( ipatch )->EMfields->update_p( rnew_dot_rnew, r_dot_r );
+        if( preconditioner ) {
+            // flexible (Polak-Ribiere) formula, robust to the inexact coarse solve
+            preconditioner->apply( *this, smpi );
+            double rnew_dot_znew_local = 0.;
+            double rnew_dot_znew = 0.;
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                rnew_dot_znew_local += preconditioner->compute_rz( *this, ipatch );
+            }
+            MPI_Allreduce( &rnew_dot_znew_local, &rnew_dot_znew, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+            preconditioner->update_p( *this, ( rnew_dot_znew - dot[1] ) / r_dot_z );
+            r_dot_z = rnew_dot_znew;
+        } else {
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                ( *this )( ipatch )->EMfields->update_p( rnew_dot_rnew, r_dot_r );
+            }
         }
 
         // compute control parameter
@@ -1478,6 +1546,11 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI *smpi )
             MESSAGE( 1, "Poisson solver converged at iteration: " << iteration
                      << ", relative err is ctrl = " << 1.0e14*ctrl << " x 1e-14" );
     }
+    if( preconditioner ) {
+        if( smpi->isMaster() )
+            MESSAGE( 1, "(multigrid preconditioner, " << preconditioner->coarseSize() << " patches in the coarse problem)" );
+        delete preconditioner;
+    }
 
     // ------------------------------------------
     // Compute the electrostatic fields Ex and Ey
@@ -1931,9 +2004,9 @@ void VectorPatch::solveRelativisticPoisson( Params &params, SmileiMPI *smpi, dou
     MPI_Allreduce( &nparticles, &nparticles_global, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD );
     MESSAGE( "GAMMA = " << gamma_global/( double )nparticles_global );
 
-    //Timer ptimer("global");
-    //ptimer.init(smpi);
-    //ptimer.restart();
+    Timer ptimer( "global" );
+    ptimer.init( smpi );
+    ptimer.restart();
 
     double gamma_mean = gamma_global/( double )nparticles_global;
 
@@ -2019,6 +2092,25 @@ void VectorPatch::solveRelativisticPoisson( Params &params, SmileiMPI *smpi, dou
     //double ctrl = rnew_dot_rnew / (double)(nx_p2_global);
     double ctrl = sqrt( rnew_dot_rnew ) / norm2_source_term; // initially is equal to one
 
+    // Multigrid preconditioner: the first direction is the preconditioned residual z = M r
+    PoissonPreconditioner *preconditioner = NULL;
+    double r_dot_z = 0.;
+    if( params.poisson_preconditioner == "multigrid" ) {
+        std::vector<double> coupling( params.nDim_field );
+        for( unsigned int d=0 ; d<params.nDim_field ; d++ ) {
+            coupling[d] = 1./( params.cell_length[d]*params.cell_length[d] );
+        }
+        coupling[0] /= gamma_mean*gamma_mean;
+        preconditioner = new PoissonPreconditioner( params, *this, coupling );
+        preconditioner->apply( *this, smpi );
+        preconditioner->update_p( *this, 0. );
+        double r_dot_z_local = 0.;
+        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            r_dot_z_local += preconditioner->compute_rz( *this, ipatch );
+        }
+        MPI_Allreduce( &r_dot_z_local, &r_dot_z, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+    }
+
     // ---------------------------------------------------------
     // Starting iterative loop for the conjugate gradient method
     // ---------------------------------------------------------
@@ -2055,23 +2147,40 @@ void VectorPatch::solveRelativisticPoisson( Params &params, SmileiMPI *smpi, dou
 
         // compute new potential and residual
         for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            ( *this )( ipatch )->EMfields->update_pand_r( r_dot_r, p_dot_Ap );
+            ( *this )( ipatch )->EMfields->update_pand_r( preconditioner ? r_dot_z : r_dot_r, p_dot_Ap );
         }
 
-        // compute new residual norm
-        rnew_dot_rnew       = 0.0;
-        rnew_dot_rnew_local = 0.0;
+        // compute new residual norm (and its product with the previous preconditioned residual)
+        double dot_local[2] = { 0., 0. };
+        double dot[2];
         for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            rnew_dot_rnew_local += ( *this )( ipatch )->EMfields->compute_r();
+            dot_local[0] += ( *this )( ipatch )->EMfields->compute_r();
+            if( preconditioner ) {
+                dot_local[1] += preconditioner->compute_rz( *this, ipatch );
+            }
         }
-        MPI_Allreduce( &rnew_dot_rnew_local, &rnew_dot_rnew, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+        MPI_Allreduce( dot_local, dot, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+        rnew_dot_rnew = dot[0];
         if( smpi->isMaster() ) {
             DEBUG( "new residual norm: rnew_dot_rnew = " << rnew_dot_rnew );
         }
 
         // compute new directio
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            ( *this )( ipatch )->EMfields->update_p( rnew_dot_rnew, r_dot_r );
+        if( preconditioner ) {
+            // flexible (Polak-Ribiere) formula, robust to the inexact coarse solve
+            preconditioner->apply( *this, smpi );
+            double rnew_dot_znew_local = 0.;
+            double rnew_dot_znew = 0.;
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                rnew_dot_znew_local += preconditioner->compute_rz( *this, ipatch );
+            }
+            MPI_Allreduce( &rnew_dot_znew_local, &rnew_dot_znew, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+            preconditioner->update_p( *this, ( rnew_dot_znew - dot[1] ) / r_dot_z );
+            r_dot_z = rnew_dot_znew;
+        } else {
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                ( *this )( ipatch )->EMfields->update_p( rnew_dot_rnew, r_dot_r );
+            }
         }
 
         // compute control parameter
@@ -2096,6 +2205,11 @@ void VectorPatch::solveRelativisticPoisson( Params &params, SmileiMPI *smpi, dou
             MESSAGE( 1, "Relativistic Poisson solver converged at iteration: " << iteration
                      << ", relative err is ctrl = " << 1.0e22*ctrl << " x 1.e-22" );
     }
+    if( preconditioner ) {
+        if( smpi->isMaster() )
+            MESSAGE( 1, "(multigrid preconditioner, " << preconditioner->coarseSize() << " patches in the coarse problem)" );
+        delete preconditioner;
+    }
 
     // ------------------------------------------
     // Compute the electromagnetic fields E and B
@@ -2307,12 +2421,8 @@ void VectorPatch::solveRelativisticPoisson( Params &params, SmileiMPI *smpi, dou
     //if (smpi->isMaster())
     //  MESSAGE(1,"Relativistic Poisson equation solved. Maximum err = ");
 
-    //ptimer.update();
-    //MESSAGE("Time in Relativistic Poisson : " << ptimer.getTime() );
-
-
-    //ptimer.update();
-    //MESSAGE("Time in Relativistic Poisson : " << ptimer.getTime() );
+    ptimer.update();
+    MESSAGE( "Time in Relativistic Poisson : " << ptimer.getTime() );
     MESSAGE( "Relativistic Poisson finished" );
 
 } // END solveRelativisticPoisson
@@ -3527,10 +3637,41 @@ void VectorPatch::applyCollisions( Params &params, int itime, Timers &timers )
     
     unsigned int ncoll = patches_[0]->vecCollisions.size();
     
-    #pragma omp for schedule(runtime)
-    for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
-        for( unsigned int icoll=0 ; icoll<ncoll; icoll++ ) {
-            patches_[ipatch]->vecCollisions[icoll]->collide( params, patches_[ipatch], itime, localDiags );
+    // When all collisions have independent bins, the bins of all patches are shared
+    // among threads, so that a few dense patches do not keep a single thread busy
+    bool independent_bins = ncoll > 0;
+    for( unsigned int icoll=0 ; icoll<ncoll; icoll++ ) {
+        independent_bins = independent_bins && patches_[0]->vecCollisions[icoll]->independent_bins();
+    }
+    
+    if( independent_bins ) {
+        unsigned int nbin = patches_[0]->vecSpecies[0]->particles->first_index.size();
+        #pragma omp for schedule(runtime)
+        for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
+            for( unsigned int icoll=0 ; icoll<ncoll; icoll++ ) {
+                patches_[ipatch]->vecCollisions[icoll]->prepare_bins( patches_[ipatch], itime );
+            }
+        }
+        #pragma omp for schedule(runtime)
+        for( unsigned int ibin_global=0 ; ibin_global<size()*nbin ; ibin_global++ ) {
+            unsigned int ipatch = ibin_global / nbin;
+            unsigned int ibin = ibin_global % nbin;
+            for( unsigned int icoll=0 ; icoll<ncoll; icoll++ ) {
+                patches_[ipatch]->vecCollisions[icoll]->collide_bin( params, patches_[ipatch], itime, ibin );
+            }
+        }
+        #pragma omp for schedule(runtime)
+        for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
+            for( unsigned int icoll=0 ; icoll<ncoll; icoll++ ) {
+                patches_[ipatch]->vecCollisions[icoll]->finish_bins();
+            }
+        }
+    } else {
+        #pragma omp for schedule(runtime)
+        for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
+            for( unsigned int icoll=0 ; icoll<ncoll; icoll++ ) {
+                patches_[ipatch]->vecCollisions[icoll]->collide( params, patches_[ipatch], itime, localDiags );
+            }
         }
     }
     
@@ -3901,6 +4042,7 @@ void VectorPatch::ponderomotiveUpdateSusceptibilityAndMomentum( Params &params,
         for( unsigned int ispec=0 ; ispec<( *this )( ipatch )->vecSpecies.size() ; ispec++ ) {
             if( ( *this )( ipatch )->vecSpecies[ispec]->isProj( time_dual, simWindow ) || diag_flag ) {
                 if( species( ipatch, ispec )->ponderomotive_dynamics ) {
+                    ( *this )( ipatch )->rand_->setStream( itime, ispec+1 );
                     if( ( *this )( ipatch )->vecSpecies[ispec]->vectorized_operators || params.cell_sorting )
                         species( ipatch, ispec )->ponderomotiveUpdateSusceptibilityAndMomentum( time_dual, ispec,
                                 emfields( ipatch ),
@@ -110,6 +110,9 @@ public :
     //! Reconfigure all patches for the new time step
     void reconfiguration( Params &params, Timers &timers, int itime );
     
+    //! Start the random number streams of all patches for the new time step
+    void setRandomStreams( int itime );
+    
     //! Particle sorting for all patches
     void sortAllParticles( Params &params );
     
@@ -1,6 +1,7 @@
 #include "Function.h"
 #include <complex>
 #include <cmath>
+#include <algorithm>
 
 using namespace std;
 
@@ -118,6 +119,226 @@ PyArrayObject *Function_Python4D::complexValueAt( std::vector<PyArrayObject *> x
 #endif
 
 
+// User-defined functions compiled by _smilei_compile_profile (pyprofiles.py)
+Function_Expression::Function_Expression( PyObject *program, unsigned int nvariables ) :
+    nvariables_( nvariables )
+{
+    PyTools::py2vector( PyTuple_GetItem( program, 0 ), op_ );
+    PyTools::py2vector( PyTuple_GetItem( program, 1 ), a_ );
+    PyTools::py2vector( PyTuple_GetItem( program, 2 ), b_ );
+    PyTools::py2vector( PyTuple_GetItem( program, 3 ), c_ );
+    PyTools::py2vector( PyTuple_GetItem( program, 4 ), value_ );
+    // Unused arguments point to the first node
+    for( unsigned int inode=0; inode<op_.size(); inode++ ) {
+        a_[inode] = std::max( a_[inode], 0 );
+        b_[inode] = std::max( b_[inode], 0 );
+        c_[inode] = std::max( c_[inode], 0 );
+    }
+}
+
+double Function_Expression::valueAt( double time )
+{
+    std::vector<const double *> x( 0 );
+    std::vector<double> nodes( op_.size() );
+    evaluate( x, time, 0, 1, 1, &nodes[0] );
+    return nodes.back();
+}
+double Function_Expression::valueAt( vector<double> x_cell, double time )
+{
+    std::vector<const double *> x( std::min( ( unsigned int ) x_cell.size(), nvariables_-1 ) );
+    for( unsigned int i=0; i<x.size(); i++ ) {
+        x[i] = &x_cell[i];
+    }
+    std::vector<double> nodes( op_.size() );
+    evaluate( x, time, 0, 1, 1, &nodes[0] );
+    return nodes.back();
+}
+double Function_Expression::valueAt( vector<double> x_cell )
+{
+    std::vector<const double *> x( std::min( ( unsigned int ) x_cell.size(), nvariables_ ) );
+    for( unsigned int i=0; i<x.size(); i++ ) {
+        x[i] = &x_cell[i];
+    }
+    std::vector<double> nodes( op_.size() );
+    evaluate( x, 0., 0, 1, 1, &nodes[0] );
+    return nodes.back();
+}
+std::complex<double> Function_Expression::complexValueAt( vector<double> x_cell, double time )
+{
+    return valueAt( x_cell, time );
+}
+std::complex<double> Function_Expression::complexValueAt( vector<double> x_cell )
+{
+    return valueAt( x_cell );
+}
+
+void Function_Expression::valuesAt( std::vector<const double *> &x, double time, unsigned int n, double *values )
+{
+    const unsigned int nnodes = op_.size();
+    const unsigned int nblocks = ( n + block_size - 1 ) / block_size;
+    #pragma omp parallel if( Tools::shareAmongThreads( n > 32768 ? n : n*nnodes ) )
+    {
+        std::vector<double> nodes( nnodes*block_size );
+        const double *result = &nodes[( nnodes-1 )*block_size];
+        #pragma omp for schedule( static )
+        for( unsigned int iblock=0; iblock<nblocks; iblock++ ) {
+            unsigned int offset = iblock*block_size;
+            unsigned int m = n-offset < block_size ? n-offset : block_size;
+            evaluate( x, time, offset, m, block_size, &nodes[0] );
+            for( unsigned int i=0; i<m; i++ ) {
+                values[offset+i] = result[i];
+            }
+        }
+    }
+}
+
+// Each node is evaluated on all the points before the next one, so that the loops are vectorized
+void Function_Expression::evaluate( std::vector<const double *> &x, double time, unsigned int offset, unsigned int n,
+                                    unsigned int stride, double *nodes )
+{
+    for( unsigned int inode=0; inode<op_.size(); inode++ ) {
+        double *__restrict__ r = &nodes[inode*stride];
+        const double *__restrict__ a = &nodes[a_[inode]*stride];
+        const double *__restrict__ b = &nodes[b_[inode]*stride];
+        const double *__restrict__ c = &nodes[c_[inode]*stride];
+        switch( op_[inode] ) {
+            case VARIABLE: {
+                unsigned int ivar = ( unsigned int ) value_[inode];
+                if( ivar < x.size() ) {
+                    const double *__restrict__ v = &x[ivar][offset];
+                    #pragma omp simd
+                    for( unsigned int i=0; i<n; i++ ) r[i] = v[i];
+                } else {
+                    #pragma omp simd
+                    for( unsigned int i=0; i<n; i++ ) r[i] = time;
+                }
+                break;
+            }
+            case CONSTANT: {
+                double v = value_[inode];
+                #pragma omp simd
+                for( unsigned int i=0; i<n; i++ ) r[i] = v;
+                break;
+            }
+            case ADD:
+                #pragma omp simd
+                for( unsigned int i=0; i<n; i++ ) r[i] = a[i] + b[i];
+                break;
+            case SUB:
+                #pragma omp simd
+                for( unsigned int i=0; i<n; i++ ) r[i] = a[i] - b[i];
+                break;
+            case MUL:
+                #pragma omp simd
+                for( unsigned int i=0; i<n; i++ ) r[i] = a[i] * b[i];
+                break;
+            case DIV:
+                #pragma omp simd
+                for( unsigned int i=0; i<n; i++ ) r[i] = a[i] / b[i];
+                break;
+            case POW:
+                for( unsigned int i=0; i<n; i++ ) r[i] = pow( a[i], b[i] );
+                break;
+            case LT:
+                #pragma omp simd
+                for( unsigned int i=0; i<n; i++ ) r[i] = a[i] <  b[i] ? 1. : 0.;
+                break;
+            case LE:
+                #pragma omp simd
+                for( unsigned int i=0; i<n; i++ ) r[i] = a[i] <= b[i] ? 1. : 0.;
+                break;
+            case GT:
+                #pragma omp simd
+                for( unsigned int i=0; i<n; i++ ) r[i] = a[i] >  b[i] ? 1. : 0.;
+                break;
+            case GE:
+                #pragma omp simd
+                for( unsigned int i=0; i<n; i++ ) r[i] = a[i] >= b[i] ? 1. : 0.;
+                break;
+            case EQ:
+                #pragma omp simd
+                for( unsigned int i=0; i<n; i++ ) r[i] = a[i] == b[i] ? 1. : 0.;
+                break;
+            case NE:
+                #pragma omp simd
+                for( unsigned int i=0; i<n; i++ ) r[i] = a[i] != b[i] ? 1. : 0.;
+                break;
+            case MIN:
+                #pragma omp simd
+                for( unsigned int i=0; i<n; i++ ) r[i] = b[i] < a[i] ? b[i] : a[i];
+                break;
+            case MAX:
+                #pragma omp simd
+                for( unsigned int i=0; i<n; i++ ) r[i] = b[i] > a[i] ? b[i] : a[i];
+                break;
+            case ATAN2:
+                for( unsigned int i=0; i<n; i++ ) r[i] = atan2( a[i], b[i] );
+                break;
+            case NEG:
+                #pragma omp simd
+                for( unsigned int i=0; i<n; i++ ) r[i] = -a[i];
+                break;
+            case ABS:
+                #pragma omp simd
+                for( unsigned int i=0; i<n; i++ ) r[i] = fabs( a[i] );
+                break;
+            case EXP:
+                for( unsigned int i=0; i<n; i++ ) r[i] = exp( a[i] );
+                break;
+            case LOG:
+                for( unsigned int i=0; i<n; i++ ) r[i] = log( a[i] );
+                break;
+            case SQRT:
+                #pragma omp simd
+                for( unsigned int i=0; i<n; i++ ) r[i] = sqrt( a[i] );
+                break;
+            case SIN:
+                for( unsigned int i=0; i<n; i++ ) r[i] = sin( a[i] );
+                break;
+            case COS:
+                for( unsigned int i=0; i<n; i++ ) r[i] = cos( a[i] );
+                break;
+            case TAN:
+                for( unsigned int i=0; i<n; i++ ) r[i] = tan( a[i] );
+                break;
+            case SINH:
+                for( unsigned int i=0; i<n; i++ ) r[i] = sinh( a[i] );
+                break;
+            case COSH:
+                for( unsigned int i=0; i<n; i++ ) r[i] = cosh( a[i] );
+                break;
+            case TANH:
+                for( unsigned int i=0; i<n; i++ ) r[i] = tanh( a[i] );
+                break;
+            case ASIN:
+                for( unsigned int i=0; i<n; i++ ) r[i] = asin( a[i] );
+                break;
+            case ACOS:
+                for( unsigned int i=0; i<n; i++ ) r[i] = acos( a[i] );
+                break;
+            case ATAN:
+                for( unsigned int i=0; i<n; i++ ) r[i] = atan( a[i] );
+                break;
+            case FLOOR:
+                #pragma omp simd
+                for( unsigned int i=0; i<n; i++ ) r[i] = floor( a[i] );
+                break;
+            case CEIL:
+                #pragma omp simd
+                for( unsigned int i=0; i<n; i++ ) r[i] = ceil( a[i] );
+                break;
+            case LOG10:
+                for( unsigned int i=0; i<n; i++ ) r[i] = log10( a[i] );
+                break;
+            case WHERE:
+                #pragma omp simd
+                for( unsigned int i=0; i<n; i++ ) r[i] = a[i] != 0. ? b[i] : c[i];
+                break;
+        }
+    }
+}
+
+
 // Constant profiles
 double Function_Constant1D::valueAt( vector<double> x_cell )
 {
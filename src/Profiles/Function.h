@@ -194,6 +194,47 @@ private:
 */
 
 
+//! User-defined python function compiled into a list of nodes (see `_smilei_compile_profile` in pyprofiles.py).
+//! Each node is a variable, a constant or an operation on previous nodes, and the last node is the result.
+//! The evaluation does not call python, and can be shared among threads.
+class Function_Expression : public Function
+{
+public:
+    //! Operation codes, as in pyprofiles.py
+    enum Operation {
+        VARIABLE = 0, CONSTANT, ADD, SUB, MUL, DIV, POW, LT, LE, GT, GE, EQ, NE, MIN, MAX, ATAN2,
+        NEG, ABS, EXP, LOG, SQRT, SIN, COS, TAN, SINH, COSH, TANH, ASIN, ACOS, ATAN, FLOOR, CEIL, LOG10,
+        WHERE
+    };
+
+    Function_Expression( PyObject *program, unsigned int nvariables );
+    Function_Expression( Function_Expression *f ) :
+        op_( f->op_ ), a_( f->a_ ), b_( f->b_ ), c_( f->c_ ), value_( f->value_ ), nvariables_( f->nvariables_ ) {};
+    double valueAt( double ); // time
+    double valueAt( std::vector<double>, double ); // space + time
+    double valueAt( std::vector<double> ); // space
+    std::complex<double> complexValueAt( std::vector<double>, double ); // space + time
+    std::complex<double> complexValueAt( std::vector<double> ); // space
+
+    //! Values at n points: x[ivar][i] is the variable ivar of the point i. If there are less arrays than
+    //! variables, the last variable is `time` for all points.
+    void valuesAt( std::vector<const double *> &x, double time, unsigned int n, double *values );
+
+private:
+    //! Evaluates the nodes on the n points from `offset`, the values of each node being separated by `stride`
+    void evaluate( std::vector<const double *> &x, double time, unsigned int offset, unsigned int n,
+                   unsigned int stride, double *nodes );
+
+    //! Number of points evaluated together
+    static const unsigned int block_size = 64;
+
+    //! Operation, arguments and value (variable index or constant) of each node
+    std::vector<int> op_, a_, b_, c_;
+    std::vector<double> value_;
+    unsigned int nvariables_;
+};
+
+
 // Children classes for hard-coded functions
 
 class Function_Constant1D : public Function
@@ -11,7 +11,8 @@ using namespace std;
 Profile::Profile( PyObject *py_profile, unsigned int nvariables, string name, bool try_numpy ) :
     profileName( "" ),
     nvariables_( nvariables ),
-    uses_numpy( false )
+    uses_numpy( false ),
+    compiled_( false )
 {
     ostringstream info_( "" );
     info_ << nvariables_ << "D";
@@ -203,6 +204,22 @@ Profile::Profile( PyObject *py_profile, unsigned int nvariables, string name, bo
         }
         
         
+        // Try to compile the function into operations evaluated without python (see pyprofiles.py)
+        PyObject *compile = PyObject_GetAttrString( PyImport_AddModule( "__main__" ), "_smilei_compile_profile" );
+        PyObject *program = compile ? PyObject_CallFunction( compile, const_cast<char *>( "Oi" ), py_profile, nvariables_ ) : NULL;
+        PyTools::checkPyError();
+        Py_XDECREF( compile );
+        if( program && program != Py_None ) {
+            function = new Function_Expression( program, nvariables_ );
+            compiled_ = true;
+            info_ << " user-defined function (compiled)";
+        }
+        Py_XDECREF( program );
+        if( compiled_ ) {
+            info = info_.str();
+            return;
+        }
+        
         // Verify that the profile transforms a float in a float
 #ifdef SMILEI_USE_NUMPY
         if( try_numpy ) {
@@ -314,7 +331,10 @@ Profile::Profile( Profile *p )
     nvariables_ = p->nvariables_;
     info        = p->info       ;
     uses_numpy  = p->uses_numpy ;
-    if( profileName != "" ) {
+    compiled_   = p->compiled_  ;
+    if( compiled_ ) {
+        function = new Function_Expression( static_cast<Function_Expression *>( p->function ) );
+    } else if( profileName != "" ) {
         if( profileName == "constant" ) {
             if( nvariables_ == 1 ) {
                 function = new Function_Constant1D( static_cast<Function_Constant1D *>( p->function ) );
@@ -49,6 +49,10 @@ public:
     {
         unsigned int nvar = coordinates.size();
         unsigned int size = coordinates[0]->globalDims_;
+        if( compiled_ ) {
+            compiledValuesAt( coordinates, NULL, 0., ret.data() );
+            return;
+        }
 #ifdef SMILEI_USE_NUMPY
         // If numpy profile, then expose coordinates as numpy before evaluating profile
         if( uses_numpy ) {
@@ -86,11 +90,49 @@ public:
         }
     };
 
+    //! Get the value of the profile (temporal) at several times, with a single call if numpy profile
+    //! Otherwise, consecutive equal times are evaluated only once
+    inline void valuesAtTimes( std::vector<double> &times, unsigned int size, std::vector<double> &ret )
+    {
+        if( size == 0 ) {
+            return;
+        }
+        if( compiled_ ) {
+            std::vector<const double *> t( 1, &times[0] );
+            static_cast<Function_Expression *>( function )->valuesAt( t, 0., size, &ret[0] );
+            return;
+        }
+#ifdef SMILEI_USE_NUMPY
+        if( uses_numpy ) {
+            npy_intp dims[1] = { ( npy_intp ) size };
+            std::vector<PyArrayObject *> t( 1 );
+            t[0] = ( PyArrayObject * )PyArray_SimpleNewFromData( 1, dims, NPY_DOUBLE, ( double * )( &times[0] ) );
+            PyArrayObject *values = function->valueAt( t );
+            Py_DECREF( t[0] );
+            double *arr = ( double * ) PyArray_GETPTR1( values, 0 );
+            for( unsigned int i=0; i<size; i++ ) {
+                ret[i] = arr[i];
+            }
+            Py_DECREF( values );
+        } else
+#endif
+        {
+            ret[0] = function->valueAt( times[0] );
+            for( unsigned int i=1; i<size; i++ ) {
+                ret[i] = times[i]==times[i-1] ? ret[i-1] : function->valueAt( times[i] );
+            }
+        }
+    };
+
     //! Get the value of the profile at several locations (spatial) and particular time
     inline void valuesAtTime( std::vector<Field *> &coordinates, double time, Field &ret )
     {
         unsigned int nvar = coordinates.size();
         unsigned int size = coordinates[0]->globalDims_;
+        if( compiled_ ) {
+            compiledValuesAt( coordinates, NULL, time, ret.data() );
+            return;
+        }
 #ifdef SMILEI_USE_NUMPY
         // If numpy profile, then expose coordinates as numpy before evaluating profile
         if( uses_numpy ) {
@@ -133,6 +175,14 @@ public:
     {
         unsigned int nvar = coordinates.size();
         unsigned int size = coordinates[0]->globalDims_;
+        if( compiled_ ) {
+            std::vector<double> values( size );
+            compiledValuesAt( coordinates, NULL, 0., &values[0] );
+            for( unsigned int i=0; i<size; i++ ) {
+                ret( i ) = values[i];
+            }
+            return;
+        }
 #ifdef SMILEI_USE_NUMPY
         // If numpy profile, then expose coordinates as numpy before evaluating profile
         if( uses_numpy ) {
@@ -175,6 +225,14 @@ public:
     {
         unsigned int nvar = coordinates.size();
         unsigned int size = coordinates[0]->globalDims_;
+        if( compiled_ ) {
+            std::vector<double> values( size );
+            compiledValuesAt( coordinates, NULL, time, &values[0] );
+            for( unsigned int i=0; i<size; i++ ) {
+                ret( i ) = values[i];
+            }
+            return;
+        }
 #ifdef SMILEI_USE_NUMPY
         // If numpy profile, then expose coordinates as numpy before evaluating profile
         if( uses_numpy ) {
@@ -218,6 +276,14 @@ public:
     {
         unsigned int nvar = coordinates.size();
         unsigned int size = coordinates[0]->globalDims_;
+        if( compiled_ ) {
+            std::vector<double> values( size );
+            compiledValuesAt( coordinates, time, 0., &values[0] );
+            for( unsigned int i=0; i<size; i++ ) {
+                ret( i ) = values[i];
+            }
+            return;
+        }
 #ifdef SMILEI_USE_NUMPY
         // If numpy profile, then expose coordinates as numpy before evaluating profile
         if( uses_numpy ) {
@@ -269,10 +335,30 @@ public:
         return info;
     };
     
+    //! Whether several threads may evaluate the profile at once (built-in or compiled, not calling python)
+    inline bool isThreadSafe()
+    {
+        return compiled_ || profileName != "";
+    };
+
     //! Name of the profile, in the case of a built-in profile
     std::string profileName;
-    
+
 private:
+    //! Values of a compiled profile at the points of `coordinates`, with the time given
+    //! either at each point by `time_field` or for all points by `time`
+    inline void compiledValuesAt( std::vector<Field *> &coordinates, Field *time_field, double time, double *ret )
+    {
+        std::vector<const double *> x( coordinates.size() );
+        for( unsigned int ivar=0; ivar<x.size(); ivar++ ) {
+            x[ivar] = coordinates[ivar]->data();
+        }
+        if( time_field ) {
+            x.push_back( time_field->data() );
+        }
+        static_cast<Function_Expression *>( function )->valuesAt( x, time, coordinates[0]->globalDims_, ret );
+    };
+    
     //! Object that holds the information on the profile function
     Function *function;
     
@@ -285,6 +371,9 @@ private:
     //! Whether the profile is using numpy
     bool uses_numpy;
     
+    //! Whether the python function was compiled into a Function_Expression
+    bool compiled_;
+    
 };//END class Profile
 
 
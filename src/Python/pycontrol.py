@@ -22,13 +22,22 @@ def _prepare_checkpoint_dir():
     if smilei_mpi_rank == 0 and (Checkpoints.dump_step>0 or Checkpoints.dump_minutes>0.):
         checkpoint_dir = "." + os.sep + "checkpoints" + os.sep
         if Checkpoints.file_grouping:
-            ngroups = int((smilei_mpi_size-1)/Checkpoints.file_grouping + 1)
+            nfiles = int((smilei_mpi_size-1)/max(1,Checkpoints.ranks_per_file) + 1)
+            ngroups = int((nfiles-1)/Checkpoints.file_grouping + 1)
             ngroups_chars = int(math.log10(ngroups))+1
             for group in range(ngroups):
                 group_dir = checkpoint_dir + '%0*d'%(ngroups_chars,group)
                 _mkdir("checkpoint", group_dir)
         else:
             _mkdir("checkpoint", checkpoint_dir)
+    # Checkpoint: the staging dir is node-local, thus created by all ranks
+    if Checkpoints.staging_dir and (Checkpoints.dump_step>0 or Checkpoints.dump_minutes>0.):
+        try:
+            os.makedirs(Checkpoints.staging_dir)
+        except:
+            pass
+        if not os.path.isdir(Checkpoints.staging_dir):
+            raise Exception("ERROR in the namelist: staging_dir "+Checkpoints.staging_dir+" cannot be created")
 
 def _smilei_check():
     """Do checks over the script"""
@@ -53,13 +62,20 @@ def _smilei_check():
             if Checkpoints.file_grouping:
                 pattern += "*"+ os.sep
             pattern += "dump-*-*.h5";
-            # pick those file that match the mpi rank
-            files = filter(lambda a: smilei_mpi_rank==int(re.search(r'dump-[0-9]*-([0-9]*).h5$',a).groups()[-1]), glob.glob(pattern))
+            files = glob.glob(pattern)
             
             if Checkpoints.restart_number is not None:
                 # pick those file that match the restart_number
                 files = filter(lambda a: Checkpoints.restart_number==int(re.search(r'dump-([0-9]*)-[0-9]*.h5$',a).groups()[-1]), files)
             
+            # pick those file that match the mpi rank
+            # (or any existing file if the previous run had a different number of files)
+            files = list(files)
+            indices = sorted(set([int(re.search(r'dump-[0-9]*-([0-9]*).h5$',a).groups()[-1]) for a in files]))
+            if len(indices) > 0:
+                file_index = smilei_mpi_rank if smilei_mpi_rank in indices else indices[smilei_mpi_rank % len(indices)]
+                files = filter(lambda a: file_index==int(re.search(r'dump-[0-9]*-([0-9]*).h5$',a).groups()[-1]), files)
+            
             Checkpoints.restart_files = list(files)
             
             if len(Checkpoints.restart_files) == 0:
@@ -139,7 +155,7 @@ def _keep_python_running():
     for s in ParticleInjector:
         profiles += [s.time_envelope, s.number_density, s.charge_density, s.particles_per_cell] + s.mean_velocity + s.temperature
     for prof in profiles:
-        if callable(prof) and not hasattr(prof,"profileName"):
+        if callable(prof) and not hasattr(prof,"profileName") and not getattr(prof,"_compiled",False):
             return True
     # Verify the tracked species that require a particle selection
     for d in DiagTrackParticles:
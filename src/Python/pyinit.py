@@ -183,6 +183,7 @@ class Main(SmileiSingleton):
     solve_poisson = True
     poisson_max_iteration = 50000
     poisson_max_error = 1.e-14
+    poisson_preconditioner = "multigrid"
 
     # Relativistic Poisson tuning
     solve_relativistic_poisson = False
@@ -193,6 +194,10 @@ class Main(SmileiSingleton):
     maxwell_solver = 'Yee'
     EM_boundary_conditions = [["periodic"]]
     EM_boundary_conditions_k = []
+    number_of_pml_cells = [10]
+    pml_reflection = 1.e-6
+    pml_kappa_max = 1.
+    pml_alpha_max = 0.
     save_magnectic_fields_for_SM = True
     time_fields_frozen = 0.
     Laser_Envelope_model = False
@@ -308,8 +313,12 @@ class Checkpoints(SmileiSingleton):
     dump_minutes = 0.
     keep_n_dumps = 2
     dump_deflate = 0
+    dump_async = False
+    dump_incremental = False
+    staging_dir = ""
     exit_after_dump = True
     file_grouping = 0
+    ranks_per_file = 1
     restart_files = []
 
 class CurrentFilter(SmileiSingleton):
@@ -354,6 +363,7 @@ class Species(SmileiComponent):
     # Particle merging species Parameters
     merging_method = "none"
     merge_every = 0
+    merge_amortized = False
     merge_min_packet_size = 4
     merge_max_packet_size = 4
     merge_min_particles_per_cell = 4
@@ -427,6 +437,8 @@ class Collisions(SmileiComponent):
     ionizing = False
     nuclear_reaction = None
     nuclear_reaction_multiplier = 0.
+    subcycling_threshold = 0.
+    subcycling_max = 10
 
 
 #diagnostics
@@ -753,3 +753,206 @@ except:
         )
         print("WARNING: LaserOffset unavailable because numpy was not found")
 
+
+
+# Compilation of user-defined profiles
+# The function is called with "tracers" instead of floats, which record the operations into a
+# list of nodes. Smilei evaluates these nodes in C++ (see Function_Expression) instead of calling
+# python at each point. The operation codes must match those of Function_Expression.
+# If the function cannot be traced (conditions on the arguments, unsupported functions, etc.)
+# or gives different results, python is used as usual.
+class _SmileiTracer(object):
+    __slots__ = ("_program", "_index")
+    __array_ufunc__ = None # numpy operators return NotImplemented
+    __hash__ = None
+    def __init__(self, program, index):
+        self._program = program
+        self._index = index
+    def __bool__(self):
+        raise TypeError("profile cannot be compiled")
+    __nonzero__ = __bool__
+    def __add__ (self, o): return self._program.node(2, self, o)
+    def __radd__(self, o): return self._program.node(2, o, self)
+    def __sub__ (self, o): return self._program.node(3, self, o)
+    def __rsub__(self, o): return self._program.node(3, o, self)
+    def __mul__ (self, o): return self._program.node(4, self, o)
+    def __rmul__(self, o): return self._program.node(4, o, self)
+    def __truediv__ (self, o): return self._program.node(5, self, o)
+    def __rtruediv__(self, o): return self._program.node(5, o, self)
+    __div__ = __truediv__
+    __rdiv__ = __rtruediv__
+    def __pow__ (self, o): return self._program.node(6, self, o)
+    def __rpow__(self, o): return self._program.node(6, o, self)
+    def __lt__(self, o): return self._program.node(7 , self, o)
+    def __le__(self, o): return self._program.node(8 , self, o)
+    def __gt__(self, o): return self._program.node(9 , self, o)
+    def __ge__(self, o): return self._program.node(10, self, o)
+    def __eq__(self, o): return self._program.node(11, self, o)
+    def __ne__(self, o): return self._program.node(12, self, o)
+    def __neg__(self): return self._program.node(16, self)
+    def __pos__(self): return self
+    def __abs__(self): return self._program.node(17, self)
+
+class _SmileiProgram(object):
+    # Operations: (number of arguments, scalar evaluation)
+    import math, operator
+    _operations = {
+        2 : (2, operator.add), 3 : (2, operator.sub), 4 : (2, operator.mul), 5 : (2, operator.truediv),
+        6 : (2, math.pow),
+        7 : (2, lambda a,b: float(a< b)), 8 : (2, lambda a,b: float(a<=b)), 9 : (2, lambda a,b: float(a> b)),
+        10: (2, lambda a,b: float(a>=b)), 11: (2, lambda a,b: float(a==b)), 12: (2, lambda a,b: float(a!=b)),
+        13: (2, lambda a,b: b if b<a else a), 14: (2, lambda a,b: b if b>a else a), 15: (2, math.atan2),
+        16: (1, operator.neg), 17: (1, abs), 18: (1, math.exp), 19: (1, math.log), 20: (1, math.sqrt),
+        21: (1, math.sin), 22: (1, math.cos), 23: (1, math.tan), 24: (1, math.sinh), 25: (1, math.cosh),
+        26: (1, math.tanh), 27: (1, math.asin), 28: (1, math.acos), 29: (1, math.atan), 30: (1, math.floor),
+        31: (1, math.ceil), 32: (1, math.log10),
+        33: (3, lambda c,a,b: a if c!=0. else b),
+    }
+    del math, operator
+    def __init__(self):
+        self.nodes = []
+        self.known = {}
+    def add(self, node):
+        key = node + (str(node[4]),) # distinguishes 0. and -0.
+        if key not in self.known:
+            if len(self.nodes) >= 10000:
+                raise TypeError("profile too long to be compiled")
+            self.known[key] = len(self.nodes)
+            self.nodes.append(node)
+        return _SmileiTracer(self, self.known[key])
+    def variable(self, i):
+        return self.add((0, -1, -1, -1, float(i)))
+    def operand(self, o):
+        import numbers
+        if isinstance(o, _SmileiTracer) and o._program is self:
+            return o._index
+        if isinstance(o, numbers.Real):
+            return self.add((1, -1, -1, -1, float(o)))._index
+        raise TypeError("profile cannot be compiled")
+    def node(self, op, *args):
+        a = [self.operand(o) for o in args] + [-1, -1]
+        return self.add((op, a[0], a[1], a[2], 0.))
+    def run(self, x):
+        values = []
+        for op, a, b, c, v in self.nodes:
+            if op == 0:
+                values += [float(x[int(v)])]
+            elif op == 1:
+                values += [v]
+            else:
+                n, f = self._operations[op]
+                values += [float(f(*[values[i] for i in (a, b, c)[:n]]))]
+        return values[-1]
+
+def _smilei_compile_profile(f, nvariables):
+    import types, math, random
+    try:
+        import numpy
+    except:
+        numpy = None
+    if not isinstance(f, types.FunctionType):
+        return None
+    program = _SmileiProgram()
+    # Traced versions of the functions of math and numpy, and of the builtins min and max
+    def traced(op, original):
+        def g(*args):
+            if any(isinstance(a, _SmileiTracer) for a in args):
+                return program.node(op, *args)
+            return original(*args)
+        return g
+    def traced_minmax(op, original):
+        def g(*args):
+            if len(args) < 2 or not any(isinstance(a, _SmileiTracer) for a in args):
+                return original(*args)
+            r = args[0]
+            for a in args[1:]:
+                r = program.node(op, r, a)
+            return r
+        return g
+    def traced_log(original):
+        def g(x, *base):
+            if base:
+                return g(x) / g(base[0])
+            return traced(19, original)(x)
+        return g
+    names = {
+        "exp":18, "log":19, "sqrt":20, "sin":21, "cos":22, "tan":23, "sinh":24, "cosh":25, "tanh":26,
+        "asin":27, "acos":28, "atan":29, "arcsin":27, "arccos":28, "arctan":29, "floor":30, "ceil":31,
+        "log10":32, "fabs":17, "abs":17, "absolute":17, "pow":6, "power":6, "atan2":15, "arctan2":15,
+        "minimum":13, "maximum":14, "where":33,
+    }
+    modules = {}
+    replacements = {}
+    for module in [math, numpy]:
+        if module is None:
+            continue
+        functions = {}
+        for name, op in names.items():
+            if hasattr(module, name):
+                original = getattr(module, name)
+                functions[name] = traced_log(original) if op==19 else traced(op, original)
+                replacements[id(original)] = functions[name]
+        if numpy is not None and module is numpy:
+            functions["square"] = lambda x: x*x
+            replacements[id(numpy.square)] = functions["square"]
+        modules[id(module)] = type("traced_"+module.__name__, (object,), dict(
+            __getattribute__ = lambda self, name, m=module, fs=functions: fs[name] if name in fs else getattr(m, name)
+        ))()
+    builtins = {"min":traced_minmax(13, min), "max":traced_minmax(14, max)}
+    for g in builtins.values():
+        replacements[id(g)] = g
+    # Copy the function and the functions it uses, with the traced functions
+    copies = {}
+    def substitute(value):
+        if id(value) in modules:
+            return modules[id(value)]
+        if id(value) in replacements:
+            return replacements[id(value)]
+        if isinstance(value, types.FunctionType):
+            return copy(value)
+        return value
+    def copy(g):
+        if id(g) in copies:
+            return copies[id(g)] or g
+        copies[id(g)] = None
+        glob = dict(builtins)
+        glob.update(g.__globals__)
+        for name in g.__code__.co_names:
+            if name in glob:
+                glob[name] = substitute(glob[name])
+        closure = None
+        if g.__closure__:
+            closure = tuple(types.CellType(substitute(c.cell_contents)) for c in g.__closure__)
+        copies[id(g)] = types.FunctionType(g.__code__, glob, g.__name__, g.__defaults__, closure)
+        copies[id(g)].__kwdefaults__ = g.__kwdefaults__
+        return copies[id(g)]
+    try:
+        result = copy(f)(*[program.variable(i) for i in range(nvariables)])
+        program.operand(result)
+        # Verify the compiled function on a few points
+        L = max([1.] + list(Main.grid_length) + [Main.simulation_time])
+        rand = random.Random(0)
+        verified = 0
+        for i in range(32):
+            x = [rand.uniform(-0.1*L, 1.1*L) for j in range(nvariables)]
+            try:
+                expected = float(f(*x))
+                value = program.run(x)
+            except:
+                continue
+            if not (value == expected or abs(value-expected) <= 1e-10*abs(expected)
+                    or (math.isnan(value) and math.isnan(expected))):
+                verified = -1
+                break
+            verified += 1
+        success = verified >= 4
+    except:
+        success = False
+    # Mark whether python is still needed for this function (see _keep_python_running)
+    try:
+        f._compiled = success and getattr(f, "_compiled", True)
+    except:
+        pass
+    if not success:
+        return None
+    return tuple( [[n[i] for n in program.nodes] for i in range(5)] )
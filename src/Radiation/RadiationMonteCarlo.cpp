@@ -129,7 +129,116 @@ void RadiationMonteCarlo::operator()(
     // _______________________________________________________________
     // Computation
 
-    for( int ipart=istart ; ipart<iend; ipart++ ) {
+    const int npart = iend - istart;
+    const double minimum_chi_discontinuous = RadiationTables.getMinimumChiDiscontinuous();
+    const double minimum_chi_continuous = RadiationTables.getMinimumChiContinuous();
+
+    if( npart > ( int )particle_gamma_.size() ) {
+        particle_gamma_.resize( npart );
+        particle_chi_.resize( npart );
+        photon_yield_.resize( npart );
+        emitting_.resize( npart );
+    }
+    double *gamma_buffer = particle_gamma_.data();
+    double *chi_buffer = particle_chi_.data();
+    double *yield_buffer = photon_yield_.data();
+    int *emitting = emitting_.data();
+
+    // First pass (vectorized): Lorentz factor and quantum parameter,
+    // and number of particles starting a new discontinuous emission
+    int n_new_tau = 0;
+    #pragma omp simd reduction(+:n_new_tau)
+    for( int i=0 ; i<npart; i++ ) {
+        int ipart = istart + i;
+        double cms = ( double )( charge[ipart] )*one_over_mass_square;
+        double g = sqrt( 1.0 + momentum[0][ipart]*momentum[0][ipart]
+                         + momentum[1][ipart]*momentum[1][ipart]
+                         + momentum[2][ipart]*momentum[2][ipart] );
+        gamma_buffer[i] = g;
+        chi_buffer[i] = Radiation::computeParticleChi( cms,
+                          momentum[0][ipart], momentum[1][ipart], momentum[2][ipart],
+                          g,
+                          Ex[ipart-ipart_ref], Ey[ipart-ipart_ref], Ez[ipart-ipart_ref],
+                          Bx[ipart-ipart_ref], By[ipart-ipart_ref], Bz[ipart-ipart_ref] );
+        n_new_tau += ( g > 1. && chi_buffer[i] > minimum_chi_discontinuous && tau[ipart] <= epsilon_tau_ ) ? 1 : 0;
+    }
+
+    // New final optical depths to reach for emission, drawn in a single batch
+    if( n_new_tau > 0 ) {
+        if( n_new_tau > ( int )random_numbers_.size() ) {
+            random_numbers_.resize( n_new_tau );
+        }
+        rand_->uniform( random_numbers_.data(), n_new_tau );
+        int irand = 0;
+        for( int i=0 ; i<npart; i++ ) {
+            int ipart = istart + i;
+            if( gamma_buffer[i] > 1. && chi_buffer[i] > minimum_chi_discontinuous && tau[ipart] <= epsilon_tau_ ) {
+                tau[ipart] = -log( random_numbers_[irand++] );
+            }
+        }
+    }
+
+    // Photon production yields (cross-section of the discontinuous emission)
+    RadiationTables.computePhotonProductionYield( chi_buffer, gamma_buffer, yield_buffer, npart );
+
+    // Second pass (vectorized): particles which do not reach their final optical depth
+    // during the whole time step, and continuous emission.
+    // The particles which emit a photon are only flagged.
+    double continuous_radiated_energy = 0;
+    #pragma omp simd reduction(+:continuous_radiated_energy)
+    for( int i=0 ; i<npart; i++ ) {
+        int ipart = istart + i;
+        double g = gamma_buffer[i];
+        int emits = 0;
+        // Does not apply the MC routine for particles with 0 kinetic energy
+        if( g > 1. ) {
+            // Discontinuous emission under progress
+            if( tau[ipart] > epsilon_tau_ ) {
+                double emission_time = std::min( tau[ipart]/yield_buffer[i], dt_ );
+                double new_tau = tau[ipart] - yield_buffer[i]*emission_time;
+                if( emission_time >= dt_ && new_tau > epsilon_tau_ ) {
+                    tau[ipart] = new_tau;
+                } else {
+                    emits = 1;
+                }
+            }
+            // New optical depth too close to 0: handled as an emission
+            else if( chi_buffer[i] > minimum_chi_discontinuous ) {
+                emits = 1;
+            }
+            // Continuous emission
+            else if( chi_buffer[i] > minimum_chi_continuous ) {
+                // Radiated energy during the time step
+                double cont_rad_energy = RadiationTables.getRidgersCorrectedRadiatedEnergy( chi_buffer[i], dt_ );
+                
+                // Effect on the momentum
+                double factor = 1. - cont_rad_energy*g/( g*g-1. );
+                momentum[0][ipart] *= factor;
+                momentum[1][ipart] *= factor;
+                momentum[2][ipart] *= factor;
+                
+                // Incrementation of the radiated energy cumulative parameter
+                continuous_radiated_energy += weight[ipart]*( g - sqrt( 1.0
+                                              + momentum[0][ipart]*momentum[0][ipart]
+                                              + momentum[1][ipart]*momentum[1][ipart]
+                                              + momentum[2][ipart]*momentum[2][ipart] ) );
+            }
+        }
+        emitting[i] = emits;
+    }
+    radiated_energy += continuous_radiated_energy;
+
+    // Compaction of the emitting particles
+    emitters_.clear();
+    for( int i=0 ; i<npart; i++ ) {
+        if( emitting[i] ) {
+            emitters_.push_back( istart + i );
+        }
+    }
+
+    // Third pass (scalar): Monte-Carlo sub-steps of the emitting particles only
+    for( unsigned int iemit=0 ; iemit<emitters_.size(); iemit++ ) {
+        int ipart = emitters_[iemit];
         charge_over_mass_square = ( double )( charge[ipart] )*one_over_mass_square;
 
         // Init local variables
@@ -101,6 +101,21 @@ protected:
     
 private:
 
+    // ________________________________________
+    // Buffers of the vectorized pass, reused between calls
+    
+    //! Lorentz factor, quantum parameter and photon production yield of the particles
+    std::vector<double> particle_gamma_;
+    std::vector<double> particle_chi_;
+    std::vector<double> photon_yield_;
+    
+    //! Random numbers for the new optical depths
+    std::vector<double> random_numbers_;
+    
+    //! Flags and indices of the particles which emit during the time step
+    std::vector<int> emitting_;
+    std::vector<int> emitters_;
+
 };
 
 #endif
@@ -170,6 +170,12 @@ void RadiationTables::initialization( Params &params , SmileiMPI *smpi )
             readTables( params, smpi );
         } else {
             MESSAGE(1,"Default tables (stored in the code) are used:");
+            
+            // A single copy of the tables is kept on each node
+            niel_.table_.share( smpi );
+            integfochi_.table_.share( smpi );
+            xi_.min_photon_chi_table_.share( smpi );
+            xi_.table_.share( smpi );
         }
     }
     
@@ -180,6 +186,9 @@ void RadiationTables::initialization( Params &params , SmileiMPI *smpi )
         MESSAGE( 2,"Dimension quantum parameter: " << integfochi_.size_particle_chi_ );
         MESSAGE( 2,"Minimum particle quantum parameter chi: " << integfochi_.min_particle_chi_ );
         MESSAGE( 2,"Maximum particle quantum parameter chi: " << integfochi_.max_particle_chi_ );
+        if( integfochi_.polynomial_.exists() ) {
+            MESSAGE( 2,"Piecewise polynomial approximation: " << integfochi_.polynomial_.size() << " bytes" );
+        }
         MESSAGE( "" );
         MESSAGE( 1,"--- Table `min_photon_chi_for_xi` and `xi`:" );
         MESSAGE( 2,"Reading of the external database" );
@@ -199,6 +208,9 @@ void RadiationTables::initialization( Params &params , SmileiMPI *smpi )
                  << niel_.min_particle_chi_ );
         MESSAGE( 2,"Maximum particle quantum parameter chi: "
                  << niel_.max_particle_chi_ );
+        if( niel_.polynomial_.exists() ) {
+            MESSAGE( 2,"Piecewise polynomial approximation: " << niel_.polynomial_.size() << " bytes" );
+        }
     }
 }
 
@@ -492,6 +504,11 @@ double RadiationTables::computePhotonProductionYield( double particle_chi, doubl
 
     logchipa = std::log10( particle_chi );
 
+    // Piecewise polynomial version of the table
+    if( integfochi_.polynomial_.exists() ) {
+        return factor_dNph_dt_*integfochi_.polynomial_.evaluate( logchipa )*particle_chi/particle_gamma;
+    }
+
     // Lower index for interpolation in the table integfochi_
     ichipa = int( floor( ( logchipa-integfochi_.log10_min_particle_chi_ )
                          *integfochi_.inv_particle_chi_delta_ ) );
@@ -517,6 +534,49 @@ double RadiationTables::computePhotonProductionYield( double particle_chi, doubl
 
 }
 
+// -----------------------------------------------------------------------------
+//! Computation of the photon production yield dNph/dt for n particles.
+//! Same interpolation as computePhotonProductionYield, written without branches
+//! so that the loop is vectorized. Outside of the table, the closest value is used.
+//! \param particle_chi particle quantum parameters
+//! \param particle_gamma particle Lorentz factors
+//! \param yield resulting photon production yields
+//! \param n number of particles
+// -----------------------------------------------------------------------------
+void RadiationTables::computePhotonProductionYield( const double * __restrict__ particle_chi,
+                                                    const double * __restrict__ particle_gamma,
+                                                    double * __restrict__ yield, int n )
+{
+    // Piecewise polynomial version of the table
+    if( integfochi_.polynomial_.exists() ) {
+        const PiecewisePolynomial &polynomial = integfochi_.polynomial_;
+        #pragma omp simd
+        for( int i = 0 ; i < n ; i++ ) {
+            yield[i] = factor_dNph_dt_*polynomial.evaluate( std::log10( particle_chi[i] ) )
+                       *particle_chi[i]/particle_gamma[i];
+        }
+        return;
+    }
+
+    const double * table = &integfochi_.table_[0];
+    const double log10_min = integfochi_.log10_min_particle_chi_;
+    const double inv_delta = integfochi_.inv_particle_chi_delta_;
+    const int imax = integfochi_.size_particle_chi_-2;
+
+    #pragma omp simd
+    for( int i = 0 ; i < n ; i++ ) {
+        double d = ( std::log10( particle_chi[i] ) - log10_min )*inv_delta;
+        // Bounded before the conversion to int (particle_chi may be 0)
+        d = std::min( std::max( d, -1. ), imax + 1. );
+        int ichipa = int( std::floor( d ) );
+        // Interpolation weight, zero outside of the table
+        double w = ( ichipa < 0 || ichipa > imax ) ? 0. : d - ichipa;
+        ichipa = std::min( std::max( ichipa, 0 ), imax );
+        double dNphdt = table[ichipa]*( 1.-w ) + table[ichipa+1]*w;
+        yield[i] = factor_dNph_dt_*dNphdt*particle_chi[i]/particle_gamma[i];
+    }
+}
+
 
 // -----------------------------------------------------------------------------
 //! Return the value of the function h(particle_chi) of Niel et al.
@@ -528,6 +588,11 @@ double RadiationTables::getHNielFromTable( double particle_chi )
     int ichipa;
     double d;
 
+    // Piecewise polynomial version of the table
+    if( niel_.polynomial_.exists() ) {
+        return niel_.polynomial_.evaluate( std::log10( particle_chi ) );
+    }
+
     // Position in the niel_.table
     d = ( std::log10( particle_chi )-niel_.log10_min_particle_chi_ )*niel_.inv_particle_chi_delta_;
     ichipa = int( floor( d ) );
@@ -611,6 +676,10 @@ void RadiationTables::readHTable( SmileiMPI *smpi )
                          &niel_.table_[0] );
 
                 H5Dclose( dataset_id );
+                
+                // Piecewise polynomial version of the table, if available
+                niel_.polynomial_.read( fileId, "h_polynomial" );
+                
                 H5Fclose( fileId );
             }
             else {
@@ -633,6 +702,7 @@ void RadiationTables::readHTable( SmileiMPI *smpi )
 
     // Bcast the table to all MPI ranks
     RadiationTables::bcastHTable( smpi );
+    niel_.polynomial_.bcast( smpi );
 }
 
 // -----------------------------------------------------------------------------
@@ -675,6 +745,10 @@ void RadiationTables::readIntegfochiTable( SmileiMPI *smpi )
                          &integfochi_.table_[0] );
 
                 H5Dclose( dataset_id );
+                
+                // Piecewise polynomial version of the table, if available
+                integfochi_.polynomial_.read( fileId, "integfochi_polynomial" );
+                
                 H5Fclose( fileId );
             } else {
                 ERROR(" Dataset `integfochi` does not exist in "<< table_path_ << "radiation_tables.h5");
@@ -684,6 +758,7 @@ void RadiationTables::readIntegfochiTable( SmileiMPI *smpi )
 
         // Bcast the table to all MPI ranks
         RadiationTables::bcastIntegfochiTable( smpi );
+        integfochi_.polynomial_.bcast( smpi );
     }
     // Else, the table can not be found, we throw an error
     else {
@@ -816,9 +891,6 @@ void RadiationTables::bcastHTable( SmileiMPI *smpi )
         buf_size = position;
         MPI_Pack_size( 2, MPI_DOUBLE, smpi->getGlobalComm(), &position );
         buf_size += position;
-        MPI_Pack_size( niel_.size_particle_chi_, MPI_DOUBLE, smpi->getGlobalComm(),
-                       &position );
-        buf_size += position;
     }
 
     //MESSAGE( 2,"Buffer size: " << buf_size );
@@ -838,10 +910,6 @@ void RadiationTables::bcastHTable( SmileiMPI *smpi )
                   1, MPI_DOUBLE, buffer, buf_size, &position, smpi->getGlobalComm() );
         MPI_Pack( &niel_.max_particle_chi_,
                   1, MPI_DOUBLE, buffer, buf_size, &position, smpi->getGlobalComm() );
-
-        MPI_Pack( &niel_.table_[0], niel_.size_particle_chi_,
-                  MPI_DOUBLE, buffer, buf_size, &position, smpi->getGlobalComm() );
-
     }
 
     // Bcast all parameters
@@ -856,17 +924,13 @@ void RadiationTables::bcastHTable( SmileiMPI *smpi )
                     &niel_.min_particle_chi_, 1, MPI_DOUBLE, smpi->getGlobalComm() );
         MPI_Unpack( buffer, buf_size, &position,
                     &niel_.max_particle_chi_, 1, MPI_DOUBLE, smpi->getGlobalComm() );
-
-        // Resize table before unpacking values
-        niel_.table_.resize( niel_.size_particle_chi_ );
-
-        MPI_Unpack( buffer, buf_size, &position, &niel_.table_[0],
-                    niel_.size_particle_chi_, MPI_DOUBLE, smpi->getGlobalComm() );
-
     }
 
     delete[] buffer;
 
+    // The table is stored once per node
+    niel_.table_.bcast( smpi );
+
     niel_.log10_min_particle_chi_ = std::log10( niel_.min_particle_chi_ );
 
     // Computation of the delta
@@ -900,9 +964,6 @@ void RadiationTables::bcastIntegfochiTable( SmileiMPI *smpi )
         buf_size = position;
         MPI_Pack_size( 2, MPI_DOUBLE, smpi->getGlobalComm(), &position );
         buf_size += position;
-        MPI_Pack_size( integfochi_.size_particle_chi_, MPI_DOUBLE, smpi->getGlobalComm(),
-                       &position );
-        buf_size += position;
     }
 
     //MESSAGE( 2,"Buffer size: " << buf_size );
@@ -922,10 +983,6 @@ void RadiationTables::bcastIntegfochiTable( SmileiMPI *smpi )
                   1, MPI_DOUBLE, buffer, buf_size, &position, smpi->getGlobalComm() );
         MPI_Pack( &integfochi_.max_particle_chi_,
                   1, MPI_DOUBLE, buffer, buf_size, &position, smpi->getGlobalComm() );
-
-        MPI_Pack( &integfochi_.table_[0], integfochi_.size_particle_chi_,
-                  MPI_DOUBLE, buffer, buf_size, &position, smpi->getGlobalComm() );
-
     }
 
     // Bcast all parameters
@@ -940,17 +997,13 @@ void RadiationTables::bcastIntegfochiTable( SmileiMPI *smpi )
                     &integfochi_.min_particle_chi_, 1, MPI_DOUBLE, smpi->getGlobalComm() );
         MPI_Unpack( buffer, buf_size, &position,
                     &integfochi_.max_particle_chi_, 1, MPI_DOUBLE, smpi->getGlobalComm() );
-
-        // Resize table before unpacking values
-        integfochi_.table_.resize( integfochi_.size_particle_chi_ );
-
-        MPI_Unpack( buffer, buf_size, &position, &integfochi_.table_[0],
-                    integfochi_.size_particle_chi_, MPI_DOUBLE, smpi->getGlobalComm() );
-
     }
 
     delete[] buffer;
 
+    // The table is stored once per node
+    integfochi_.table_.bcast( smpi );
+
     integfochi_.log10_min_particle_chi_ = std::log10( integfochi_.min_particle_chi_ );
 
     // Computation of the delta
@@ -1010,12 +1063,6 @@ void RadiationTables::bcastTableXi( SmileiMPI *smpi )
         buf_size = position;
         MPI_Pack_size( 2, MPI_DOUBLE, smpi->getGlobalComm(), &position );
         buf_size += position;
-        MPI_Pack_size( xi_.size_particle_chi_, MPI_DOUBLE, smpi->getGlobalComm(),
-                       &position );
-        buf_size += position;
-        MPI_Pack_size( xi_.size_particle_chi_*xi_.size_photon_chi_, MPI_DOUBLE,
-                       smpi->getGlobalComm(), &position );
-        buf_size += position;
     }
 
     //MESSAGE( 2,"Buffer size for MPI exchange: " << buf_size );
@@ -1037,12 +1084,6 @@ void RadiationTables::bcastTableXi( SmileiMPI *smpi )
                   1, MPI_DOUBLE, buffer, buf_size, &position, smpi->getGlobalComm() );
         MPI_Pack( &xi_.max_particle_chi_,
                   1, MPI_DOUBLE, buffer, buf_size, &position, smpi->getGlobalComm() );
-
-        MPI_Pack( &xi_.min_photon_chi_table_[0], xi_.size_particle_chi_,
-                  MPI_DOUBLE, buffer, buf_size, &position, smpi->getGlobalComm() );
-
-        MPI_Pack( &xi_.table_[0], xi_.size_particle_chi_*xi_.size_photon_chi_,
-                  MPI_DOUBLE, buffer, buf_size, &position, smpi->getGlobalComm() );
     }
 
     // Bcast all parameters
@@ -1059,21 +1100,14 @@ void RadiationTables::bcastTableXi( SmileiMPI *smpi )
                     &xi_.min_particle_chi_, 1, MPI_DOUBLE, smpi->getGlobalComm() );
         MPI_Unpack( buffer, buf_size, &position,
                     &xi_.max_particle_chi_, 1, MPI_DOUBLE, smpi->getGlobalComm() );
-
-        // Resize tables before unpacking values
-        xi_.min_photon_chi_table_.resize( xi_.size_particle_chi_ );
-        xi_.table_.resize( xi_.size_particle_chi_*xi_.size_photon_chi_ );
-
-        MPI_Unpack( buffer, buf_size, &position, &xi_.min_photon_chi_table_[0],
-                    xi_.size_particle_chi_, MPI_DOUBLE, smpi->getGlobalComm() );
-
-        MPI_Unpack( buffer, buf_size, &position, &xi_.table_[0],
-                    xi_.size_particle_chi_*xi_.size_photon_chi_, MPI_DOUBLE, smpi->getGlobalComm() );
-                    
     }
 
     delete[] buffer;
 
+    // The tables are stored once per node
+    xi_.min_photon_chi_table_.bcast( smpi );
+    xi_.table_.bcast( smpi );
+
     // Log10 of xi_.min_particle_chi_ for efficiency
     xi_.log10_min_particle_chi_ = std::log10( xi_.min_particle_chi_ );
 
@@ -24,6 +24,8 @@
 #include "RadiationTools.h"
 #include "H5.h"
 #include "Random.h"
+#include "PiecewisePolynomial.h"
+#include "SharedArray.h"
 
 //------------------------------------------------------------------------------
 //! RadiationTables class: holds parameters, tables and functions to compute
@@ -55,6 +57,14 @@ public:
     //! also the cross-section for the Monte-Carlo
     double computePhotonProductionYield( double particle_chi, double particle_gamma );
 
+    //! Photon production yields of n particles (vectorized version of the above)
+    //! \param particle_chi quantum parameters of the particles
+    //! \param particle_gamma Lorentz factors of the particles
+    //! \param yield resulting photon production yields
+    //! \param n number of particles
+    void computePhotonProductionYield( const double *particle_chi, const double *particle_gamma,
+                                       double *yield, int n );
+
     //! Determine randomly a photon quantum parameter photon_chi
     //! for an emission process
     //! from a particle chi value (particle_chi) and
@@ -214,7 +224,7 @@ private:
         
         //! Array containing tabulated values of the function h for the
         //! stochastic diffusive operator of Niel et al.
-        std::vector<double > table_;
+        SharedArray table_;
         
         //! Minimum boundary of the table h
         double min_particle_chi_;
@@ -237,6 +247,9 @@ private:
         //! Dimension of the array h
         int size_particle_chi_;
         
+        //! Piecewise polynomial approximation of h, used instead of table_ when read from the file
+        PiecewisePolynomial polynomial_;
+        
     };
     
     struct Niel niel_;
@@ -252,7 +265,7 @@ private:
         //! (which is also the optical depth for the Monte-Carlo process).
         //! This table is the integration of the Synchrotron emissivity
         //! refers to as F over the quantum parameter Chi.
-        std::vector<double > table_;
+        SharedArray table_;
         
         //! Minimum boundary of the table integfochi_table
         double min_particle_chi_;
@@ -272,6 +285,9 @@ private:
         //! Inverse delta chi for the table integfochi_table
         double inv_particle_chi_delta_;
         
+        //! Piecewise polynomial approximation of the table, used instead of table_ when read from the file
+        PiecewisePolynomial polynomial_;
+        
     };
     
     struct IntegrationFoverChi integfochi_;
@@ -284,12 +300,12 @@ private:
         
         //! Table containing the cumulative distribution function \f$P(0 \rightarrow \chi_{\gamma})\f$
         //! that gives gives the probability for a photon emission in the range \f$[0, \chi_{\gamma}]\f$
-        std::vector<double> table_ ;
+        SharedArray table_;
         
         //! Table containing the photon_chi min values
         //! Under this value, photon energy is
         //! considered negligible
-        std::vector<double > min_photon_chi_table_;
+        SharedArray min_photon_chi_table_;
         
         //! Logarithm of the minimum boundary for particle_chi in the table xip
         //! and xip_chiphmin
@@ -342,6 +342,9 @@ int main( int argc, char *argv[] )
                 vecPatches.reconfiguration( params, timers, itime );
             }
 
+            // start the random number streams of this iteration
+            vecPatches.setRandomStreams( itime );
+
             // apply collisions if requested
             vecPatches.applyCollisions( params, itime, timers );
 
@@ -0,0 +1,81 @@
+#include "SharedArray.h"
+
+#include <cstring>
+
+#include "SmileiMPI.h"
+
+using namespace std;
+
+SharedArray::~SharedArray()
+{
+    freeWindow();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Broadcast the values of the MPI master to the shared memory of all nodes
+//! Only the masters of the nodes receive the values, and store them in the shared memory
+// ---------------------------------------------------------------------------------------------------------------------
+void SharedArray::bcast( SmileiMPI *smpi )
+{
+    moveToWindow( smpi, true );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Move the values, identical on all processes, to the shared memory of the node
+// ---------------------------------------------------------------------------------------------------------------------
+void SharedArray::share( SmileiMPI *smpi )
+{
+    moveToWindow( smpi, false );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Allocate the shared memory of the node, fill it with the local values of the master of the node
+//! (or of the MPI master if `from_master`), and free the local values
+// ---------------------------------------------------------------------------------------------------------------------
+void SharedArray::moveToWindow( SmileiMPI *smpi, bool from_master )
+{
+    unsigned long size = size_;
+    if( from_master ) {
+        MPI_Bcast( &size, 1, MPI_UNSIGNED_LONG, 0, smpi->getGlobalComm() );
+    }
+
+    // A previous window is replaced by the new values
+    freeWindow();
+
+    // Only the master of the node allocates memory
+    MPI_Aint bytes = smpi->isNodeMaster() ? size*sizeof( double ) : 0;
+    double *base;
+    MPI_Win_allocate_shared( bytes, sizeof( double ), MPI_INFO_NULL, smpi->getNodeComm(), &base, &window_ );
+    double *shared;
+    int disp_unit;
+    MPI_Win_shared_query( window_, 0, &bytes, &disp_unit, &shared );
+
+    MPI_Win_fence( 0, window_ );
+    if( smpi->isNodeMaster() && size > 0 ) {
+        if( ! from_master || smpi->isMaster() ) {
+            memcpy( shared, &local_[0], size*sizeof( double ) );
+        }
+        if( from_master ) {
+            MPI_Bcast( shared, size, MPI_DOUBLE, 0, smpi->getNodeMastersComm() );
+        }
+    }
+    MPI_Win_fence( 0, window_ );
+
+    data_ = shared;
+    size_ = size;
+    vector<double>().swap( local_ );
+}
+
+void SharedArray::freeWindow()
+{
+    if( window_ == MPI_WIN_NULL ) {
+        return;
+    }
+    // Tables may be destroyed after MPI_Finalize
+    int finalized;
+    MPI_Finalized( &finalized );
+    if( ! finalized ) {
+        MPI_Win_free( &window_ );
+    }
+    window_ = MPI_WIN_NULL;
+}
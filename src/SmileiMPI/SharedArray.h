@@ -0,0 +1,81 @@
+#ifndef SHAREDARRAY_H
+#define SHAREDARRAY_H
+
+#include <vector>
+#include <initializer_list>
+#include <cstddef>
+
+#include <mpi.h>
+
+class SmileiMPI;
+
+//! Read-only array of doubles stored once per node, in a MPI-3 shared memory window.
+//! The values are first set locally (resize and fill, or assign a list), then the array is either
+//! broadcast from the MPI master (bcast) or shared when all processes hold the same values (share).
+//! After this, the local copies are freed and all the processes of a node read the same memory.
+class SharedArray
+{
+public:
+    SharedArray() : data_( NULL ), size_( 0 ), window_( MPI_WIN_NULL ) {};
+    ~SharedArray();
+
+    //! The window cannot be copied
+    SharedArray( const SharedArray & ) = delete;
+    SharedArray &operator=( const SharedArray & ) = delete;
+
+    //! Set the local values
+    inline SharedArray &operator=( std::initializer_list<double> values )
+    {
+        local_ = values;
+        data_ = local_.data();
+        size_ = local_.size();
+        return *this;
+    }
+
+    //! Resize the local array
+    inline void resize( std::size_t size )
+    {
+        local_.resize( size );
+        data_ = local_.data();
+        size_ = size;
+    }
+
+    inline double &operator[]( std::size_t i )
+    {
+        return data_[i];
+    }
+
+    inline const double &operator[]( std::size_t i ) const
+    {
+        return data_[i];
+    }
+
+    inline std::size_t size() const
+    {
+        return size_;
+    }
+
+    //! Broadcast the values of the MPI master to the shared memory of all nodes
+    void bcast( SmileiMPI *smpi );
+
+    //! Move the values, identical on all processes, to the shared memory of the node
+    void share( SmileiMPI *smpi );
+
+private:
+    //! Move the local values to the shared memory of the node
+    void moveToWindow( SmileiMPI *smpi, bool from_master );
+
+    void freeWindow();
+
+    //! Values read by the process: either local_ or the shared memory
+    double *data_;
+    std::size_t size_;
+
+    //! Local values, before they are moved to the shared memory
+    std::vector<double> local_;
+
+    //! Shared memory window of the node
+    MPI_Win window_;
+};
+
+#endif
@@ -64,9 +64,22 @@ SmileiMPI::SmileiMPI( int *argc, char ***argv )
     MPI_Comm_size( SMILEI_COMM_WORLD, &smilei_sz );
     MPI_Comm_rank( SMILEI_COMM_WORLD, &smilei_rk );
 
+    initNodeComms();
+
 } // END SmileiMPI::SmileiMPI
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Create the communicator of the processes of each node, and the communicator of the node masters
+// ---------------------------------------------------------------------------------------------------------------------
+void SmileiMPI::initNodeComms()
+{
+    MPI_Comm_split_type( SMILEI_COMM_WORLD, MPI_COMM_TYPE_SHARED, smilei_rk, MPI_INFO_NULL, &SMILEI_COMM_NODE );
+    MPI_Comm_rank( SMILEI_COMM_NODE, &node_rk );
+    MPI_Comm_split( SMILEI_COMM_WORLD, node_rk==0 ? 0 : MPI_UNDEFINED, smilei_rk, &SMILEI_COMM_NODE_MASTERS );
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // SmileiMPI destructor :
 //     - Call MPI_Finalize
@@ -75,6 +88,11 @@ SmileiMPI::~SmileiMPI()
 {
     delete[]periods_;
 
+    if( SMILEI_COMM_NODE_MASTERS != MPI_COMM_NULL ) {
+        MPI_Comm_free( &SMILEI_COMM_NODE_MASTERS );
+    }
+    MPI_Comm_free( &SMILEI_COMM_NODE );
+
     MPI_Finalize();
 
 } // END SmileiMPI::~SmileiMPI
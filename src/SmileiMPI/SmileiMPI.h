@@ -25,6 +25,7 @@ class DiagnosticScreen;
 class DiagnosticRadiationSpectrum;
 
 #define SMILEI_COMM_DUMP_TIME 16777216
+#define SMILEI_COMM_DUMP_TOKEN 16777217
 
 //  --------------------------------------------------------------------------------------------------------------------
 //! Class SmileiMPI
@@ -49,6 +50,9 @@ public:
     // Broadcast an int in current communicator
     void bcast( int &val );
 
+    //! Create the communicators of the nodes, used to share read-only data between processes
+    void initNodeComms();
+
     //! Initialize  MPI (per process) environment
     //! \param params Parameters
     virtual void init( Params &params, DomainDecomposition *domain_decomposition );
@@ -152,6 +156,24 @@ public:
         return SMILEI_COMM_WORLD;
     }
 
+    //! Return the communicator of the MPI processes sharing the memory of the node
+    inline MPI_Comm getNodeComm()
+    {
+        return SMILEI_COMM_NODE;
+    }
+
+    //! Return the communicator of the first MPI process of each node (MPI_COMM_NULL on the other processes)
+    inline MPI_Comm getNodeMastersComm()
+    {
+        return SMILEI_COMM_NODE_MASTERS;
+    }
+
+    //! Whether the process is the first one of its node
+    inline bool isNodeMaster()
+    {
+        return ( node_rk==0 );
+    }
+
     //! Return MPI_Comm_size
     inline int getOMPMaxThreads()
     {
@@ -239,10 +261,17 @@ protected:
     //! Global MPI Communicator
     MPI_Comm SMILEI_COMM_WORLD;
 
+    //! Communicator of the MPI processes sharing the memory of the node
+    MPI_Comm SMILEI_COMM_NODE;
+    //! Communicator of the first MPI process of each node
+    MPI_Comm SMILEI_COMM_NODE_MASTERS;
+
     //! Number of MPI process in the current communicator
     int smilei_sz;
     //! MPI process Id in the current communicator
     int smilei_rk;
+    //! MPI process Id in the node communicator
+    int node_rk;
     //! OMP max number of threads in one MPI
     int smilei_omp_max_threads;
 
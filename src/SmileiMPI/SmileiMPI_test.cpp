@@ -70,6 +70,8 @@ SmileiMPI_test::SmileiMPI_test( int *argc, char ***argv )
     MPI_Comm_size( SMILEI_COMM_WORLD, &smilei_sz );
     MPI_Comm_rank( SMILEI_COMM_WORLD, &smilei_rk );
     
+    initNodeComms();
+    
     if( smilei_sz > 1 ) {
         ERROR( "Test mode cannot be run with several MPI processes. Instead, indicate the MPIxOMP intended partition after the -T argument." );
     }
@@ -86,7 +86,8 @@ Species::Species( Params &params, Patch *patch ) :
     tracking_diagnostic( 10000 ),
     nDim_particle( params.nDim_particle ),
     nDim_field(    params.nDim_field  ),
-    merging_time_selection_( 0 )
+    merging_time_selection_( 0 ),
+    merge_amortized_( false )
 {
     regular_number_array_.clear();
     partBoundCond = NULL;
@@ -1039,49 +1040,22 @@ void Species::importParticles( Params &params, Patch *patch, Particles &source_p
         src_bin_keys[i] /= params.clrw;
     }
 
+    // Sort the new particles by bin (counting sort)
     vector<int> bin_count( nbin, 0 );
-    for( unsigned int ip=0; ip < npart ; ip++ )
+    for( unsigned int ip=0; ip < npart ; ip++ ) {
         bin_count[src_bin_keys[ip]] ++;
+    }
+    vector<int> bin_start( nbin, 0 );
+    for( unsigned int ibin = 1 ; ibin < nbin ; ibin++ ) {
+        bin_start[ibin] = bin_start[ibin-1] + bin_count[ibin-1];
+    }
+    vector<int> src_index( npart );
+    for( unsigned int ip=0; ip < npart ; ip++ ) {
+        src_index[bin_start[src_bin_keys[ip]]++] = ip;
+    }
 
-    // sort new parts par bins
-    int istart = 0;
-    int istop  = bin_count[0];
-
-    for ( int ibin = 0 ; ibin < (int)nbin ; ibin++ ) {
-        if (bin_count[ibin]!=0) {
-            for( int ip=istart; ip < istop ; ip++ ) {
-                if ( src_bin_keys[ip] == ibin )
-                    continue;
-                else { // rearrange particles
-                    int ip_swap = istop;
-                    while (( src_bin_keys[ip_swap] != ibin ) && (ip_swap<(int)npart))
-                        ip_swap++;
-                    source_particles.swapParticle(ip, ip_swap);
-                    int tmp = src_bin_keys[ip];
-                    src_bin_keys[ip] = src_bin_keys[ip_swap];
-                    src_bin_keys[ip_swap] = tmp;
-                } // rearrange particles
-            } // end loop on particles of a cell
-
-            // inject in main data structure per cell
-            source_particles.copyParticles( istart, bin_count[ibin],
-                                        *particles,
-                                        particles->first_index[ibin] );
-            particles->last_index[ibin] += bin_count[ibin];
-            for ( unsigned int idx=ibin+1 ; idx<particles->last_index.size() ; idx++ ) {
-                particles->first_index[idx] += bin_count[ibin];
-                particles->last_index[idx]  += bin_count[ibin];
-            }
-
-        }
-        // update istart/istop fot the next cell
-        istart += bin_count[ibin];
-        if ( ibin != (int)nbin-1  )
-            istop  += bin_count[ibin+1];
-        else
-            istop = npart;
-
-    } // End cell loop
+    // Inject in the main data structure, at the beginning of each bin
+    particles->insertParticlesInBins( source_particles, src_index, bin_count );
 
     source_particles.clear();
 }
@@ -1137,7 +1111,7 @@ void Species::setXminBoundaryCondition()
 // ---------------------------------------------------------------------------------------------------------------------
 // Particle merging cell by cell
 // ---------------------------------------------------------------------------------------------------------------------
-void Species::mergeParticles( double time_dual, unsigned int ispec,
+void Species::mergeParticles( double time_dual, int itime, unsigned int ispec,
                               Params &params,
                               Patch *patch, SmileiMPI *smpi,
                               std::vector<Diagnostic *> &localDiags ) {}
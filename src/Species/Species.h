@@ -252,6 +252,9 @@ public:
     //! Time selection for the particle merging
     TimeSelection *merging_time_selection_;
 
+    //! Flag to spread the merging of the cells over the period of the time selection
+    bool merge_amortized_;
+
     //! Minimum number of particles in a packet that can be merged
     //! at the same time
     unsigned int merge_min_packet_size_;
@@ -411,7 +414,7 @@ public:
                                             std::vector<Diagnostic *> &localDiags );
 
     //! Method performing the merging of particles
-    virtual void mergeParticles( double time_dual, unsigned int ispec,
+    virtual void mergeParticles( double time_dual, int itime, unsigned int ispec,
                                  Params &params,
                                  Patch *patch, SmileiMPI *smpi,
                                  std::vector<Diagnostic *> &localDiags );
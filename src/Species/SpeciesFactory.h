@@ -327,6 +327,9 @@ public:
                 );
             }
 
+            // Merging spread over the period of the time selection
+            PyTools::extract( "merge_amortized", this_species->merge_amortized_ , "Species", ispec );
+
             // get extra parameters
             // Minimum particle number per packet to merge
             PyTools::extract( "merge_min_packet_size", this_species->merge_min_packet_size_ , "Species", ispec );
@@ -453,6 +456,9 @@ public:
                      << this_species->merging_method_ );
             MESSAGE( 3, "| Merging time selection: "
                      << this_species->merging_time_selection_->info() );
+            if( this_species->merge_amortized_ ) {
+                MESSAGE( 3, "| Amortized: cells merged in turn at each iteration");
+            }
             if (this_species->merge_log_scale_) {
                 MESSAGE( 3, "| Discretization scale: log");
                 MESSAGE( 3, "| Minimum momentum: " << std::scientific << std::setprecision(5)
@@ -968,6 +974,7 @@ public:
         new_species->merging_method_                          = species->merging_method_;
         new_species->has_merging_                             = species->has_merging_;
         new_species->merging_time_selection_                  = species->merging_time_selection_;
+        new_species->merge_amortized_                         = species->merge_amortized_;
         new_species->merge_log_scale_                         = species->merge_log_scale_;
         new_species->merge_min_momentum_log_scale_            = species->merge_min_momentum_log_scale_;
         new_species->merge_min_particles_per_cell_            = species->merge_min_particles_per_cell_;
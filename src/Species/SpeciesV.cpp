@@ -755,55 +755,28 @@ void SpeciesV::importParticles( Params &params, Patch *patch, Particles &source_
             src_cell_keys[ip] = src_cell_keys[ip] * length[ipos] + IX;
         }
     }
+    // Sort the new particles by cell (counting sort)
     vector<int> src_count( ncells, 0 );
-    for( unsigned int ip=0; ip < npart ; ip++ )
+    for( unsigned int ip=0; ip < npart ; ip++ ) {
         src_count[src_cell_keys[ip]] ++;
+    }
+    vector<int> src_start( ncells, 0 );
+    for( unsigned int icell = 1 ; icell < ncells ; icell++ ) {
+        src_start[icell] = src_start[icell-1] + src_count[icell-1];
+    }
+    vector<int> src_index( npart );
+    for( unsigned int ip=0; ip < npart ; ip++ ) {
+        src_index[src_start[src_cell_keys[ip]]++] = ip;
+    }
 
-    // sort new parts par cells
-    int istart = 0;
-    int istop  = src_count[0];
-
-    for ( int icell = 0 ; icell < (int)ncells ; icell++ ) {
-        if (src_count[icell]!=0) {
-            for( int ip=istart; ip < istop ; ip++ ) {
-                if ( src_cell_keys[ip] == icell )
-                    continue;
-                else { // rearrange particles
-                    int ip_swap = istop;
-                    while (( src_cell_keys[ip_swap] != icell ) && (ip_swap<(int)npart))
-                        ip_swap++;
-                    source_particles.swapParticle(ip, ip_swap);
-                    int tmp = src_cell_keys[ip];
-                    src_cell_keys[ip] = src_cell_keys[ip_swap];
-                    src_cell_keys[ip_swap] = tmp;
-                } // rearrange particles
-            } // end loop on particles of a cell
-
-            // inject in main data structure per cell
-            source_particles.copyParticles( istart, src_count[icell],
-                                        *particles,
-                                        particles->first_index[icell] );
-            particles->last_index[icell] += src_count[icell];
-            for ( unsigned int idx=icell+1 ; idx<particles->last_index.size() ; idx++ ) {
-                particles->first_index[idx] += src_count[icell];
-                particles->last_index[idx]  += src_count[icell];
-            }
-            count[icell] += src_count[icell];
-
-        }
-        // update istart/istop fot the next cell
-        istart += src_count[icell];
-        if ( icell != (int)ncells-1  )
-            istop  += src_count[icell+1];
-        else
-            istop = npart;
-
-    } // End cell loop
-    //source_particles.clear();
+    // Inject in the main data structure, at the beginning of each cell
+    particles->insertParticlesInBins( source_particles, src_index, src_count );
+    for( unsigned int icell = 0 ; icell < ncells ; icell++ ) {
+        count[icell] += src_count[icell];
+    }
 
     // Set place for new particles in species->particles->cell_keys
-    for (unsigned int ip=0;ip<npart ; ip++ )
-        addSpaceForOneParticle();
+    particles->cell_keys.resize( particles->cell_keys.size() + npart, -1 );
 
     source_particles.clear();
 
@@ -812,7 +785,7 @@ void SpeciesV::importParticles( Params &params, Patch *patch, Particles &source_
 // ---------------------------------------------------------------------------------------------------------------------
 //! Particle merging cell by cell
 // ---------------------------------------------------------------------------------------------------------------------
-void SpeciesV::mergeParticles( double time_dual, unsigned int ispec,
+void SpeciesV::mergeParticles( double time_dual, int itime, unsigned int ispec,
                                Params &params,
                                Patch *patch, SmileiMPI *smpi,
                                std::vector<Diagnostic *> &localDiags )
@@ -847,8 +820,17 @@ void SpeciesV::mergeParticles( double time_dual, unsigned int ispec,
         //         energy_before += sqrt(1 + pow(particles->momentum(0,ip),2) + pow(particles->momentum(1,ip),2) + pow(particles->momentum(2,ip),2));
         // }
 
+        // Amortized merging: only one cell out of `stride` is merged at each
+        // iteration, so that each cell is merged once per period
+        unsigned int stride = 1;
+        unsigned int first_cell = 0;
+        if( merge_amortized_ ) {
+            stride = std::max( merging_time_selection_->smallestInterval(), 1 );
+            first_cell = itime % stride;
+        }
+
         // For each cell, we apply independently the merging process
-        for( scell = 0 ; scell < particles->first_index.size() ; scell++ ) {
+        for( scell = first_cell ; scell < particles->first_index.size() ; scell += stride ) {
             
             ( *Merge )( mass_, *particles, mask, smpi, particles->first_index[scell],
                         particles->last_index[scell], count[scell]);
@@ -88,7 +88,7 @@ public:
     void importParticles( Params &, Patch *, Particles &, std::vector<Diagnostic *> & )override;
 
     //! Method performing the merging of particles
-    virtual void mergeParticles( double time_dual, unsigned int ispec,
+    virtual void mergeParticles( double time_dual, int itime, unsigned int ispec,
                                  Params &params,
                                  Patch *patch,
                                  SmileiMPI *smpi,
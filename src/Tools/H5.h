@@ -54,7 +54,7 @@ public:
 
     
     //! Attempt to open a file but does not display an error
-    static hid_t Fopen( std::string file ) {
+    static hid_t Fopen( std::string file, unsigned int flags = H5F_ACC_RDWR ) {
         // Backup default error printing
         H5E_auto2_t old_func;
         void *old_client_data;
@@ -62,7 +62,7 @@ public:
         H5Eset_auto( H5E_DEFAULT, NULL, NULL );
         
         // Open
-        hid_t status = H5Fopen( file.c_str(), H5F_ACC_RDWR, H5P_DEFAULT );
+        hid_t status = H5Fopen( file.c_str(), flags, H5P_DEFAULT );
         
         // Check error stack size
         if( H5Eget_num( H5E_DEFAULT ) > 0 ) {
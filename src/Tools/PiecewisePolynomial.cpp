@@ -0,0 +1,66 @@
+#include "PiecewisePolynomial.h"
+
+#include <mpi.h>
+
+#include "SmileiMPI.h"
+
+using namespace std;
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Read the coefficients and the attributes of the dataset `name`, as written by smilei_tables
+//! Returns false if the file does not contain this dataset
+// ---------------------------------------------------------------------------------------------------------------------
+bool PiecewisePolynomial::read( hid_t fileId, string name )
+{
+    if( H5Lexists( fileId, name.c_str(), H5P_DEFAULT ) <= 0 ) {
+        return false;
+    }
+
+    hid_t dataset_id = H5Dopen( fileId, name.c_str(), H5P_DEFAULT );
+    double min, max;
+    H5::getAttr( dataset_id, "min", min );
+    H5::getAttr( dataset_id, "max", max );
+    H5::getAttr( dataset_id, "number_of_segments", number_of_segments_ );
+    H5::getAttr( dataset_id, "degree", degree_ );
+    log10_values_ = 0;
+    if( H5::hasAttr( dataset_id, "log10_values" ) ) {
+        H5::getAttr( dataset_id, "log10_values", log10_values_ );
+    }
+    H5Dclose( dataset_id );
+
+    H5::getVect( fileId, name, coefficients_, true );
+    if( coefficients_.size() != ( unsigned int )( number_of_segments_*( degree_+1 ) ) ) {
+        ERROR( "Dataset " << name << " has " << coefficients_.size() << " coefficients instead of "
+               << number_of_segments_*( degree_+1 ) );
+    }
+
+    log10_min_ = log10( min );
+    log10_max_ = log10( max );
+    inv_segment_length_ = number_of_segments_ / ( log10_max_ - log10_min_ );
+
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Bcast of the polynomial from the rank 0 (which may have no polynomial)
+// ---------------------------------------------------------------------------------------------------------------------
+void PiecewisePolynomial::bcast( SmileiMPI *smpi )
+{
+    int sizes[3] = { number_of_segments_, degree_, log10_values_ };
+    MPI_Bcast( sizes, 3, MPI_INT, 0, smpi->getGlobalComm() );
+    number_of_segments_ = sizes[0];
+    degree_ = sizes[1];
+    log10_values_ = sizes[2];
+    if( number_of_segments_ == 0 ) {
+        return;
+    }
+
+    double bounds[3] = { log10_min_, log10_max_, inv_segment_length_ };
+    MPI_Bcast( bounds, 3, MPI_DOUBLE, 0, smpi->getGlobalComm() );
+    log10_min_ = bounds[0];
+    log10_max_ = bounds[1];
+    inv_segment_length_ = bounds[2];
+
+    coefficients_.resize( number_of_segments_*( degree_+1 ) );
+    MPI_Bcast( &coefficients_[0], coefficients_.size(), MPI_DOUBLE, 0, smpi->getGlobalComm() );
+}
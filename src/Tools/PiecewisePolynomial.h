@@ -0,0 +1,75 @@
+#ifndef PIECEWISEPOLYNOMIAL_H
+#define PIECEWISEPOLYNOMIAL_H
+
+#include <vector>
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include "H5.h"
+
+class SmileiMPI;
+
+//! Piecewise polynomial approximation of a function of log10(x), generated by the tool smilei_tables.
+//! The range [log10(min), log10(max)] is split in segments of equal length, in which the function is
+//! a polynomial of the local variable t in [0,1]. Compared to a linearly interpolated table, it needs
+//! much fewer values for a better accuracy, and its evaluation has no branch.
+class PiecewisePolynomial
+{
+public:
+    PiecewisePolynomial() : number_of_segments_( 0 ), degree_( 0 ), log10_values_( 0 ) {};
+    ~PiecewisePolynomial() {};
+
+    //! Read the dataset `name` of an open file, if it exists
+    bool read( hid_t fileId, std::string name );
+
+    //! Bcast from the rank 0 to all ranks
+    void bcast( SmileiMPI *smpi );
+
+    //! Whether the polynomial is defined
+    inline bool exists() const
+    {
+        return number_of_segments_ > 0;
+    }
+
+    //! Value at log10_x. Out of the bounds, the value at the closest bound is returned
+    //! The polynomial approximates either the function or its log10 (log10_values_)
+    inline double evaluate( double log10_x ) const
+    {
+        double d = ( log10_x - log10_min_ )*inv_segment_length_;
+        d = std::min( std::max( d, 0. ), ( double ) number_of_segments_ );
+        int iseg = std::min( int( d ), number_of_segments_-1 );
+        double t = d - iseg;
+        const double *c = &coefficients_[iseg*( degree_+1 )];
+        double value = c[degree_];
+        for( int p = degree_-1 ; p >= 0 ; p-- ) {
+            value = value*t + c[p];
+        }
+        return log10_values_ ? std::pow( 10., value ) : value;
+    }
+
+    //! Memory used by the coefficients
+    inline unsigned int size() const
+    {
+        return coefficients_.size()*sizeof( double );
+    }
+
+private:
+    //! log10 of the bounds
+    double log10_min_;
+    double log10_max_;
+
+    //! Inverse length of a segment in log10 scale
+    double inv_segment_length_;
+
+    //! Number of segments, and degree of the polynomials
+    int number_of_segments_;
+    int degree_;
+
+    //! Whether the polynomial approximates the log10 of the function
+    int log10_values_;
+
+    //! Coefficients of the polynomials, lowest order first, degree_+1 for each segment
+    std::vector<double> coefficients_;
+};
+
+#endif
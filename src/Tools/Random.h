@@ -5,49 +5,63 @@
 #include <inttypes.h>
 #include <cmath>
 
+//! Counter-based random number generator (Philox4x32-10, Salmon et al., SC'11)
+//! Each random number is a function of a key (seed, patch, ...) and of a counter (stream, position).
+//! No state needs to be carried from one iteration to the next: the sequence only depends on
+//! the seed and on the stream numbers, not on the thread or process which draws it.
 class Random
 {
 public:
-    Random( unsigned int seed ) {
-        // Initialize the state of the random number generator
-        xorshift32_state = seed;
-        // Ensure that the random seed is different for each patch
-        xorshift32_state += std::rand();
-        // zero is not acceptable for xorshift
-        if( xorshift32_state==0 ) {
-            xorshift32_state = 1073741824;
-        }
+    //! Generator of a patch: its stream must be set at each iteration (see setStream)
+    Random( unsigned int seed, uint64_t stream1 ) {
+        setKey( mix64( mix64( seed ) ^ stream1 ) );
+        setStream( 0 );
+    };
+
+    //! Generator of an independent stream: the sequence only depends on the seed and on the stream
+    //! numbers (e.g. patch, bin, iteration)
+    Random( unsigned int seed, uint64_t stream1, uint64_t stream2, uint64_t stream3 ) {
+        setKey( mix64( mix64( seed ) ^ stream1 ) );
+        uint64_t s = mix64( mix64( stream2 ) ^ stream3 );
+        setStream( ( uint32_t ) s, ( uint32_t )( s >> 32 ) );
     };
-    
+
     ~Random() {};
-    
+
+    //! Restart the sequence at the beginning of a new stream (e.g. iteration, species)
+    inline void setStream( uint32_t stream, uint32_t substream = 0 ) {
+        stream_[0] = stream;
+        stream_[1] = substream;
+        counter_ = 0;
+        index_ = 4;
+        has_spare_ = false;
+    }
+
     //! random integer
     inline uint32_t integer() {
-        return xorshift32();
+        return next();
     }
-    //! Uniform rand from xorshift32 generator, between 0 (excluded) and 1 (included)
+    //! Uniform rand between 0 (excluded) and 1 (included)
     inline double uniform() {
-        return xorshift32() * xorshift32_invmax;
+        return ( next() + 1. ) * invmax;
     }
-    //! Uniform rand from xorshift32 generator, between 0 (excluded) and 1-10^-11
+    //! Uniform rand between 0 (excluded) and 1-10^-11
     inline double uniform1() {
-        return xorshift32() * xorshift32_invmax1;
+        return ( next() + 1. ) * invmax1;
     }
-    //! Uniform rand from xorshift32 generator, between -1. (excluded) and 1. (included)
+    //! Uniform rand between -1. (excluded) and 1. (included)
     inline double uniform2() {
-        return xorshift32() * xorshift32_invmax2 - 1.;
+        return ( next() + 1. ) * invmax2 - 1.;
     }
-    //! Uniform rand from xorshift32 generator, between 0. (excluded) and 2 pi (included)
+    //! Uniform rand between 0. (excluded) and 2 pi (included)
     inline double uniform_2pi() {
-        return xorshift32() * xorshift32_invmax_2pi;
+        return ( next() + 1. ) * invmax_2pi;
     }
-    //! Normal rand from xorshift32 generator (std deviation = 1.)
+    //! Normal rand (std deviation = 1.)
     inline double normal() {
-        static double spare;
-        static bool has_spare = false;
-        if( has_spare ) {
-            has_spare = false;
-            return spare;
+        if( has_spare_ ) {
+            has_spare_ = false;
+            return spare_;
         } else {
             double u, v, s;
             do {
@@ -56,35 +70,127 @@ public:
                 s = u*u + v*v;
             } while( s >= 1. );
             s = std::sqrt( -2. * std::log(s) / s );
-            spare = v * s;
-            has_spare = true;
+            spare_ = v * s;
+            has_spare_ = true;
             return u * s;
         }
     }
 
-    //! State of the random number generator
-    uint32_t xorshift32_state;
+    //! Fill r with n uniform rands between 0 (excluded) and 1 (included)
+    //! The blocks of the counter are independent, so that the loop is vectorized
+    inline void uniform( double * __restrict__ r, unsigned int n ) {
+        const unsigned int nblocks = n / 4;
+        const uint64_t c0 = counter_;
+        const uint32_t k0 = key_[0], k1 = key_[1], s0 = stream_[0], s1 = stream_[1];
+        #pragma omp simd
+        for( unsigned int ib = 0; ib < nblocks; ib++ ) {
+            uint32_t x[4];
+            philox( c0 + ib, s0, s1, k0, k1, x );
+            for( unsigned int k = 0; k < 4; k++ ) {
+                r[4*ib+k] = ( x[k] + 1. ) * invmax;
+            }
+        }
+        counter_ += nblocks;
+        index_ = 4;
+        for( unsigned int i = 4*nblocks; i < n; i++ ) {
+            r[i] = uniform();
+        }
+    }
+
+    //! Fill r with n normal rands (std deviation = 1.), using the Box-Muller transform
+    inline void normal( double * __restrict__ r, unsigned int n ) {
+        const unsigned int nblocks = n / 4;
+        const uint64_t c0 = counter_;
+        const uint32_t k0 = key_[0], k1 = key_[1], s0 = stream_[0], s1 = stream_[1];
+        #pragma omp simd
+        for( unsigned int ib = 0; ib < nblocks; ib++ ) {
+            uint32_t x[4];
+            philox( c0 + ib, s0, s1, k0, k1, x );
+            for( unsigned int k = 0; k < 4; k+=2 ) {
+                double a = std::sqrt( -2. * std::log( ( x[k] + 1. ) * invmax ) );
+                double phi = ( x[k+1] + 1. ) * invmax_2pi;
+                r[4*ib+k  ] = a * std::cos( phi );
+                r[4*ib+k+1] = a * std::sin( phi );
+            }
+        }
+        counter_ += nblocks;
+        index_ = 4;
+        for( unsigned int i = 4*nblocks; i < n; i++ ) {
+            r[i] = normal();
+        }
+    }
+
+    //! Philox4x32-10 bijection of the counter (c, s0, s1) with the key (k0, k1)
+    static inline void philox( uint64_t c, uint32_t s0, uint32_t s1, uint32_t k0, uint32_t k1, uint32_t x[4] )
+    {
+        uint32_t x0 = ( uint32_t ) c, x1 = ( uint32_t )( c >> 32 ), x2 = s0, x3 = s1;
+        for( unsigned int round = 0; round < 10; round++ ) {
+            uint64_t p0 = ( uint64_t ) 0xD2511F53 * x0;
+            uint64_t p1 = ( uint64_t ) 0xCD9E8D57 * x2;
+            uint32_t y0 = ( uint32_t )( p1 >> 32 ) ^ x1 ^ k0;
+            uint32_t y2 = ( uint32_t )( p0 >> 32 ) ^ x3 ^ k1;
+            x1 = ( uint32_t ) p1;
+            x3 = ( uint32_t ) p0;
+            x0 = y0;
+            x2 = y2;
+            k0 += 0x9E3779B9;
+            k1 += 0xBB67AE85;
+        }
+        x[0] = x0;
+        x[1] = x1;
+        x[2] = x2;
+        x[3] = x3;
+    }
 
 private:
-    
-    //! Random number generator
-    inline uint32_t xorshift32()
+
+    //! Mixing function of splitmix64: consecutive inputs give uncorrelated outputs
+    static inline uint64_t mix64( uint64_t z )
+    {
+        z += 0x9e3779b97f4a7c15ULL;
+        z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+        z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebULL;
+        return z ^ ( z >> 31 );
+    }
+
+    inline void setKey( uint64_t key ) {
+        key_[0] = ( uint32_t ) key;
+        key_[1] = ( uint32_t )( key >> 32 );
+    }
+
+    //! Next random integer: each call of philox provides 4 of them
+    inline uint32_t next()
     {
-        /* Algorithm "xor" from p. 4 of Marsaglia, "Xorshift RNGs" */
-        xorshift32_state ^= xorshift32_state << 13;
-        xorshift32_state ^= xorshift32_state >> 17;
-        xorshift32_state ^= xorshift32_state << 5;
-        return xorshift32_state;
+        if( index_ == 4 ) {
+            philox( counter_, stream_[0], stream_[1], key_[0], key_[1], buffer_ );
+            counter_++;
+            index_ = 0;
+        }
+        return buffer_[index_++];
     }
+
+    //! Key of the generator
+    uint32_t key_[2];
+    //! Current stream (upper half of the counter)
+    uint32_t stream_[2];
+    //! Position in the stream (lower half of the counter)
+    uint64_t counter_;
+    //! Last random integers drawn, and index of the next one to be used
+    uint32_t buffer_[4];
+    unsigned int index_;
+    //! Second number of the last pair drawn by normal()
+    double spare_;
+    bool has_spare_;
+
     //! Inverse of the maximum value of the random number generator
-    static constexpr double xorshift32_invmax = 1./4294967296.;
+    static constexpr double invmax = 1./4294967296.;
     //! Almost inverse of the maximum value of the random number generator
-    static constexpr double xorshift32_invmax1 = (1.-1e-11)/4294967296.;
+    static constexpr double invmax1 = (1.-1e-11)/4294967296.;
     //! Twice inverse of the maximum value of the random number generator
-    static constexpr double xorshift32_invmax2 = 2./4294967296.;
-     //! two pi * inverse of the maximum value of the random number generator
-    static constexpr double xorshift32_invmax_2pi = 2.*M_PI/4294967296.;
-    
+    static constexpr double invmax2 = 2./4294967296.;
+    //! two pi * inverse of the maximum value of the random number generator
+    static constexpr double invmax_2pi = 2.*M_PI/4294967296.;
+
 };
 
 
@@ -120,6 +120,17 @@ public:
     
     static std::string xyz;
     
+    //! Whether the loops on a grid of `number_of_points` should be shared among the OpenMP threads:
+    //! only for large grids treated out of the OpenMP parallel regions (regions of the uncoupled grids)
+    static inline bool shareAmongThreads( unsigned int number_of_points )
+    {
+#ifdef _OMP
+        return number_of_points >= 32768 && ! omp_in_parallel();
+#else
+        return false;
+#endif
+    };
+    
     //! Concatenate several strings
     template<class T1, class T2, class T3=std::string, class T4=std::string>
     static std::string merge( T1 s1, T2 s2, T3 s3="", T4 s4="" )
@@ -457,6 +457,24 @@ public:
             return -1;
         }
     }
+    
+    //! write the coefficients of a piecewise polynomial (see Tools::computePiecewisePolynomial)
+    //! log10_values indicates that the polynomial approximates the log10 of the function
+    static void polynomial( hid_t locationId, std::string name, std::vector<double> &coefficients,
+                            double min, double max, int number_of_segments, int degree, int log10_values = 0 )
+    {
+        vect( locationId, name, coefficients, 0 );
+        std::string attr_name( "min" );
+        attr( locationId, name, attr_name, min );
+        attr_name = "max";
+        attr( locationId, name, attr_name, max );
+        attr_name = "number_of_segments";
+        attr( locationId, name, attr_name, number_of_segments );
+        attr_name = "degree";
+        attr( locationId, name, attr_name, degree );
+        attr_name = "log10_values";
+        attr( locationId, name, attr_name, log10_values );
+    }
 };
 
 #endif
@@ -68,6 +68,11 @@ void MultiphotonBreitWheeler::createTables(int argc, std::string * arguments)
     std::vector <double> table_1d;
     std::vector <double> table_2d;
     
+    // Piecewise polynomial approximation of the 1d table
+    std::vector <double> polynomial;
+    int polynomial_segments;
+    int polynomial_degree;
+    
     // Parameter default initialization
     size_particle_chi      = 128;
     size_photon_chi        = 128;
@@ -76,6 +81,8 @@ void MultiphotonBreitWheeler::createTables(int argc, std::string * arguments)
     xi_power               = 5;
     xi_threshold           = 1e-9;
     number_of_draws        = 0;
+    polynomial_segments    = 32;
+    polynomial_degree      = 5;
     verbose                = false;
     
     std::string help_message;
@@ -88,6 +95,7 @@ void MultiphotonBreitWheeler::createTables(int argc, std::string * arguments)
     help_message += " -e, --error      int             compute error due to discretization and use the provided int as a number of draws. (default 0)\n";
     help_message += " -t, --threshold  double          Minimum targeted value of xi in the computation the minimum photon quantum parameter. (default 1e-3)\n";
     help_message += " -p, --power      int             Maximum decrease in order of magnitude for the search for the minimum photon quantum parameter. (default 4)\n";
+    help_message += " -c, --polynomial int int         number of segments and degree of the piecewise polynomial 1d table, 0 segments to disable. (default 32 5)\n";
     help_message += " -v, --verbose                    Dump the tables\n";
     
     // Read from command line
@@ -110,6 +118,10 @@ void MultiphotonBreitWheeler::createTables(int argc, std::string * arguments)
         } else if (arguments[i_arg] == "-p" || arguments[i_arg] == "--power") {
             xi_power = std::stod(arguments[i_arg+1]);
             i_arg+=2;
+        } else if (arguments[i_arg] == "-c" || arguments[i_arg] == "--polynomial") {
+            polynomial_segments = std::stoi(arguments[i_arg+1]);
+            polynomial_degree = std::stoi(arguments[i_arg+2]);
+            i_arg+=3;
         } else if (arguments[i_arg] == "-v" || arguments[i_arg] == "--verbose") {
             verbose = true;
             i_arg+=1;
@@ -230,6 +242,21 @@ void MultiphotonBreitWheeler::createTables(int argc, std::string * arguments)
         std::cout << " Total time: " << t1 - t0 << " s" << std::endl;
     }
     
+    // Piecewise polynomial approximation
+    // T spans many orders of magnitude at low photon chi: its log10 is approximated
+    if (polynomial_segments > 0) {
+        t0 = MPI_Wtime();
+        Tools::computePiecewisePolynomial( [] (double chi) {
+                return log10( 2.0*MultiphotonBreitWheeler::computeIntegrationRitusDerivative( chi, 0.5*chi, 200, 1e-15 ) );
+            }, log10_min_photon_chi, log10_max_photon_chi,
+            polynomial_segments, polynomial_degree, polynomial );
+        t1 = MPI_Wtime();
+        if (rank==0) {
+            std::cout << " Piecewise polynomial: " << polynomial_segments << " segments of degree "
+                      << polynomial_degree << " - " << t1 - t0 << " s" << std::endl;
+        }
+    }
+    
     // Error evaluation
     if (number_of_draws > 0) {
         std::default_random_engine generator;
@@ -243,6 +270,8 @@ void MultiphotonBreitWheeler::createTables(int argc, std::string * arguments)
         double interpolated_value_for_max_error;
         double distance;
         int index;
+        double local_max_polynomial_error = 0;
+        double max_polynomial_error = 0;
         
         if (rank==0) std::cout << " Error computation: " << std::endl;
         
@@ -259,14 +288,25 @@ void MultiphotonBreitWheeler::createTables(int argc, std::string * arguments)
                 value_for_max_error = value;
                 interpolated_value_for_max_error = interpolated_value;
             }
+            if (polynomial_segments > 0) {
+                interpolated_value = pow( 10., Tools::evaluatePiecewisePolynomial( polynomial,
+                    log10_min_photon_chi, log10_max_photon_chi,
+                    polynomial_segments, polynomial_degree, log10(photon_chi) ) );
+                error = std::abs(2.0*value - interpolated_value)/(2.0*value);
+                local_max_polynomial_error = std::max(local_max_polynomial_error,error);
+            }
         }
     
         MPI_Reduce(&local_max_error,&max_error,1,MPI_DOUBLE,MPI_MAX,0,MPI_COMM_WORLD);
+        MPI_Reduce(&local_max_polynomial_error,&max_polynomial_error,1,MPI_DOUBLE,MPI_MAX,0,MPI_COMM_WORLD);
         
         if (rank==0) {
             std::cout << " - Maximal relative error: " << max_error << " at index " << index
                       << " " << value_for_max_error << " " << interpolated_value_for_max_error
                       << std::endl;
+            if (polynomial_segments > 0) {
+                std::cout << " - Maximal relative error of the piecewise polynomial: " << max_polynomial_error << std::endl;
+            }
         }
     }
     
@@ -301,6 +341,11 @@ void MultiphotonBreitWheeler::createTables(int argc, std::string * arguments)
         
         attr_name = "size_photon_chi";
         H5::attr( fileId, vect_name, attr_name, size_photon_chi);
+        
+        if (polynomial_segments > 0) {
+            H5::polynomial( fileId, "integration_dt_dchi_polynomial", polynomial,
+                min_photon_chi, max_photon_chi, polynomial_segments, polynomial_degree, 1 );
+        }
 
         H5Fclose( fileId );
     }
@@ -63,6 +63,11 @@ void NonlinearComptonScattering::createTables(int argc, std::string * arguments)
     std::vector <double> table_1d;
     std::vector <double> table_2d;
     
+    // Piecewise polynomial approximation of the 1d tables
+    std::vector <double> polynomial;
+    int polynomial_segments;
+    int polynomial_degree;
+    
     bool verbose;
     
     // Parameter default initialization
@@ -73,6 +78,8 @@ void NonlinearComptonScattering::createTables(int argc, std::string * arguments)
     xi_power               = 4;
     xi_threshold           = 1e-3;
     number_of_draws        = 0;
+    polynomial_segments    = 32;
+    polynomial_degree      = 5;
     verbose                = false;
     
     std::string help_message;
@@ -85,6 +92,7 @@ void NonlinearComptonScattering::createTables(int argc, std::string * arguments)
     help_message += " -e, --error      int             compute error due to discretization and use the provided int as a number of draws. (default 0)\n";
     help_message += " -t, --threshold  double          Minimum targeted value of xi in the computation the minimum particle quantum parameter. (default 1e-3)\n";
     help_message += " -p, --power      int             Maximum decrease in order of magnitude for the search for the minimum particle quantum parameter. (default 4)\n";
+    help_message += " -c, --polynomial int int         number of segments and degree of the piecewise polynomial 1d tables, 0 segments to disable. (default 32 5)\n";
     help_message += " -v, --verbose                    Dump the tables\n";
     
     // Read from command line
@@ -107,6 +115,10 @@ void NonlinearComptonScattering::createTables(int argc, std::string * arguments)
         } else if (arguments[i_arg] == "-p" || arguments[i_arg] == "--power") {
             xi_power = std::stod(arguments[i_arg+1]);
             i_arg+=2;
+        } else if (arguments[i_arg] == "-c" || arguments[i_arg] == "--polynomial") {
+            polynomial_segments = std::stoi(arguments[i_arg+1]);
+            polynomial_degree = std::stoi(arguments[i_arg+2]);
+            i_arg+=3;
         } else if (arguments[i_arg] == "-v" || arguments[i_arg] == "--verbose") {
             verbose = true;
             i_arg+=1;
@@ -226,6 +238,20 @@ void NonlinearComptonScattering::createTables(int argc, std::string * arguments)
         std::cout << " Total time: " << t1 - t0 << " s" << std::endl;
     }
     
+    // Piecewise polynomial approximation
+    if (polynomial_segments > 0) {
+        t0 = MPI_Wtime();
+        Tools::computePiecewisePolynomial( [] (double chi) {
+                return NonlinearComptonScattering::integrateSynchrotronEmissivity( chi, 1e-40*chi, chi, 400, 1e-15 );
+            }, log10_min_particle_chi, log10_max_particle_chi,
+            polynomial_segments, polynomial_degree, polynomial );
+        t1 = MPI_Wtime();
+        if (rank==0) {
+            std::cout << " Piecewise polynomial: " << polynomial_segments << " segments of degree "
+                      << polynomial_degree << " - " << t1 - t0 << " s" << std::endl;
+        }
+    }
+    
     // Error evaluation
     if (number_of_draws > 0) {
         std::default_random_engine generator;
@@ -235,6 +261,8 @@ void NonlinearComptonScattering::createTables(int argc, std::string * arguments)
         double error;
         double local_max_error = 0;
         double max_error = 0;
+        double local_max_polynomial_error = 0;
+        double max_polynomial_error = 0;
         double distance;
         
         if (rank==0) std::cout << " Error computation: " << std::endl;
@@ -248,12 +276,23 @@ void NonlinearComptonScattering::createTables(int argc, std::string * arguments)
             interpolated_value = table_1d[i_particle_chi]*(1 - distance) + table_1d[i_particle_chi+1]*distance;
             error = std::abs(value - interpolated_value)/value;
             local_max_error = std::max(local_max_error,error);
+            if (polynomial_segments > 0) {
+                interpolated_value = Tools::evaluatePiecewisePolynomial( polynomial,
+                    log10_min_particle_chi, log10_max_particle_chi,
+                    polynomial_segments, polynomial_degree, log10(particle_chi) );
+                error = std::abs(value - interpolated_value)/value;
+                local_max_polynomial_error = std::max(local_max_polynomial_error,error);
+            }
         }
     
         MPI_Reduce(&local_max_error,&max_error,1,MPI_DOUBLE,MPI_MAX,0,MPI_COMM_WORLD);
+        MPI_Reduce(&local_max_polynomial_error,&max_polynomial_error,1,MPI_DOUBLE,MPI_MAX,0,MPI_COMM_WORLD);
         
         if (rank==0) {
             std::cout << " - Maximal relative error: " << max_error << std::endl;
+            if (polynomial_segments > 0) {
+                std::cout << " - Maximal relative error of the piecewise polynomial: " << max_polynomial_error << std::endl;
+            }
         }
     }
     
@@ -288,6 +327,11 @@ void NonlinearComptonScattering::createTables(int argc, std::string * arguments)
         
         attr_name = "size_particle_chi";
         H5::attr( fileId, vect_name, attr_name, size_particle_chi);
+        
+        if (polynomial_segments > 0) {
+            H5::polynomial( fileId, "integfochi_polynomial", polynomial,
+                min_particle_chi, max_particle_chi, polynomial_segments, polynomial_degree );
+        }
 
         H5Fclose( fileId );
     }
@@ -336,6 +380,14 @@ void NonlinearComptonScattering::createTables(int argc, std::string * arguments)
                     &table_1d[0], &rank_indexes[0], &rank_first_index[0],
                     MPI_DOUBLE, MPI_COMM_WORLD );
     
+    // Piecewise polynomial approximation
+    if (polynomial_segments > 0) {
+        Tools::computePiecewisePolynomial( [] (double chi) {
+                return NonlinearComptonScattering::computeHNiel( chi, 400, 1e-15 );
+            }, log10_min_particle_chi, log10_max_particle_chi,
+            polynomial_segments, polynomial_degree, polynomial );
+    }
+    
     // Output of the tables
     if (verbose && rank == 0) {
         std:: cout << "\n table h for Niel: " << std::setprecision(std::numeric_limits<double>::digits10 + 1) <<std::endl;
@@ -366,6 +418,11 @@ void NonlinearComptonScattering::createTables(int argc, std::string * arguments)
         
         attr_name = "size_particle_chi";
         H5::attr( fileId, vect_name, attr_name, size_particle_chi);
+        
+        if (polynomial_segments > 0) {
+            H5::polynomial( fileId, "h_polynomial", polynomial,
+                min_particle_chi, max_particle_chi, polynomial_segments, polynomial_degree );
+        }
 
         H5Fclose( fileId );
     }
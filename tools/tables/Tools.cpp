@@ -196,3 +196,102 @@ double Tools::asymptoticBesselK(double nu, double z)
     
     return K;
 }
+
+// ----------------------------------------------------------------------------
+//! \brief Piecewise polynomial approximation of a function in log10 scale
+//
+//! \param f function to approximate
+//! \param log10_min log10 of the lower bound
+//! \param log10_max log10 of the upper bound
+//! \param number_of_segments number of segments of equal length in log10 scale
+//! \param degree degree of the polynomial in each segment
+//! \param coefficients resulting coefficients, (degree+1) per segment, lowest order first
+// ----------------------------------------------------------------------------
+void Tools::computePiecewisePolynomial( std::function<double(double)> f,
+    double log10_min, double log10_max,
+    int number_of_segments, int degree,
+    std::vector<double> &coefficients )
+{
+    int rank;
+    int number_of_ranks;
+    MPI_Comm_size( MPI_COMM_WORLD, &number_of_ranks );
+    MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+    
+    const int n = degree+1;
+    const int number_of_nodes = number_of_segments*n;
+    const double width = ( log10_max - log10_min )/number_of_segments;
+    
+    // Chebyshev nodes in [-1, 1]
+    std::vector<double> nodes( n );
+    for( int j = 0 ; j < n ; j++ ) {
+        nodes[j] = std::cos( M_PI*( j+0.5 )/n );
+    }
+    
+    // Evaluation of f on the nodes of all segments
+    int *rank_first_index = new int[number_of_ranks];
+    int *rank_indexes = new int[number_of_ranks];
+    distributeArray( number_of_ranks, number_of_nodes, rank_first_index, rank_indexes );
+    
+    std::vector<double> buffer( std::max( rank_indexes[rank], 1 ) );
+    std::vector<double> values( number_of_nodes );
+    for( int i = 0 ; i < rank_indexes[rank] ; i++ ) {
+        int inode = rank_first_index[rank] + i;
+        double log10_x = log10_min + ( inode/n + 0.5*( nodes[inode%n] + 1. ) )*width;
+        buffer[i] = f( std::pow( 10., log10_x ) );
+    }
+    MPI_Allgatherv( &buffer[0], rank_indexes[rank], MPI_DOUBLE,
+                    &values[0], &rank_indexes[0], &rank_first_index[0],
+                    MPI_DOUBLE, MPI_COMM_WORLD );
+    
+    delete [] rank_first_index;
+    delete [] rank_indexes;
+    
+    // Monomial coefficients of the Chebyshev polynomials T_k(2t-1)
+    std::vector<std::vector<double> > T( n, std::vector<double>( n, 0. ) );
+    T[0][0] = 1.;
+    if( n > 1 ) {
+        T[1][0] = -1.;
+        T[1][1] = 2.;
+    }
+    for( int k = 2 ; k < n ; k++ ) {
+        for( int p = 0 ; p < n ; p++ ) {
+            T[k][p] = - 2.*T[k-1][p] - T[k-2][p] + ( p > 0 ? 4.*T[k-1][p-1] : 0. );
+        }
+    }
+    
+    // Chebyshev coefficients of each segment, converted to monomial coefficients
+    coefficients.assign( number_of_nodes, 0. );
+    for( int iseg = 0 ; iseg < number_of_segments ; iseg++ ) {
+        for( int k = 0 ; k < n ; k++ ) {
+            double a = 0.;
+            for( int j = 0 ; j < n ; j++ ) {
+                a += values[iseg*n+j] * std::cos( M_PI*k*( j+0.5 )/n );
+            }
+            a *= ( k == 0 ? 1. : 2. )/n;
+            for( int p = 0 ; p < n ; p++ ) {
+                coefficients[iseg*n+p] += a*T[k][p];
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Evaluation of a piecewise polynomial computed by computePiecewisePolynomial
+//! Outside of the bounds, the value at the closest bound is returned.
+// ----------------------------------------------------------------------------
+double Tools::evaluatePiecewisePolynomial( std::vector<double> &coefficients,
+    double log10_min, double log10_max,
+    int number_of_segments, int degree,
+    double log10_x )
+{
+    const int n = degree+1;
+    double d = ( log10_x - log10_min )*number_of_segments/( log10_max - log10_min );
+    d = std::min( std::max( d, 0. ), ( double )number_of_segments );
+    int iseg = std::min( int( d ), number_of_segments-1 );
+    double t = d - iseg;
+    double value = coefficients[iseg*n+degree];
+    for( int p = degree-1 ; p >= 0 ; p-- ) {
+        value = value*t + coefficients[iseg*n+p];
+    }
+    return value;
+}
@@ -13,6 +13,7 @@
 #include <vector>
 #include <string>
 #include <cmath>
+#include <functional>
 #include <mpi.h>
 #include <stdio.h>
 #include <boost/math/special_functions/bessel.hpp> 
@@ -53,6 +54,21 @@ class Tools
         //! This method provides the asymptotic behaviors for large
         //! z of the second kind modified Bessel function K
         static double asymptoticBesselK(double nu, double z);
+        
+        //! Piecewise polynomial approximation of f between 10^log10_min and 10^log10_max:
+        //! uniform segments in log10 scale, with a Chebyshev interpolation of the given degree
+        //! in each segment, stored as monomial coefficients of the local variable t in [0,1].
+        //! The evaluations of f are distributed between MPI processes.
+        static void computePiecewisePolynomial( std::function<double(double)> f,
+            double log10_min, double log10_max,
+            int number_of_segments, int degree,
+            std::vector<double> &coefficients );
+        
+        //! Evaluation of the piecewise polynomial at log10_x (same as in Smilei)
+        static double evaluatePiecewisePolynomial( std::vector<double> &coefficients,
+            double log10_min, double log10_max,
+            int number_of_segments, int degree,
+            double log10_x );
                                          
 };
 